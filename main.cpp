@@ -9,50 +9,133 @@ Contact: fredrick.brommer@usm.edu
 Date: October 20, 2018
 */
 
+
+#include "puzzleSolver.h"
+
 #include <iostream>
 #include <string>
 #include <fstream>
 #include <limits>
 #include <algorithm>
-#include <stack>
-#include <queue>
 #include <chrono>
-#include <list>
+#include <queue>
 #include <vector>
+#include <cstring>
+#include <cstdint>
+#include <cctype>
+#include <iomanip>
+#include <sstream>
+#include <atomic>
+#include <new>
+#include <mutex>
+#include <memory>
+#include <deque>
+#include <thread>
+#include <condition_variable>
+#include <cerrno>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 
 using namespace std;
 
-//Variable to hold the length of the puzzle
-#define PUZZLE_LENGTH 9
+//This is the struct that holds the results of one solver over one corpus
+struct BenchmarkRow
+{
+    string solver;                      //Holds the solver name
+    string corpus;                      //Holds the corpus name
+    double timePerSolve;                //Holds the average seconds per solve
+    double nodesPerSecond;              //Holds the number of nodes created per second
+    double averageLength;               //Holds the average solution length
+    double averageMemory;               //Holds the average memory per solve in bytes
+    int unsolved;                       //Holds the number of instances without a solution
+};
+
+//Number of latency buckets the solver server keeps for each search. Bucket b counts the
+//answers that took from 2^b up to 2^(b+1) microseconds.
+#define SERVER_HISTOGRAM_BUCKETS 32
+
+//Most bytes the solver server reads from a client at once
+#define SERVER_READ_SIZE 65536
 
-//This is the struct defined to be used in out list when the search is being performed
-struct State
+//Longest request line the solver server accepts. A board line is well under 100 bytes, so a
+//client sending more than this without an end of line is cut off.
+#define SERVER_MAX_REQUEST 4096
+
+//Seconds and megabytes a solver server search may use unless --time-limit or --memory say otherwise
+#define SERVER_DEFAULT_TIME_LIMIT 10.0
+#define SERVER_DEFAULT_MEMORY_MB 512.0
+
+//This is the struct that holds a client of the solver server. The socket is closed once the
+//reader and every job still waiting to answer the client have let go of it.
+struct ServerConnection
 {
-    int currentState[PUZZLE_LENGTH];    //Holds the current array (puzzle)
-    int spaceLocation;                  //Holds the location of the empty slot
-    int misplacedTiles;                 //Holds the number of misplaced tiles
-    int manhattanDistance;              //Holds the number of manhattan distance
-    int moveCount;                      //Holds the number of times the space has moved
+    int socket;                         //Holds the connected socket
+    mutex writeMutex;                   //Keeps answers from different workers from mixing
     
-    State* parent;                      //Holds the parent of the node for tracing path
+    ServerConnection(int clientSocket) : socket(clientSocket) {}
+    ~ServerConnection() { close(socket); }
 };
 
-// Comparison object to be used to order the heap for Misplaced tles
-struct comp
+//This is the struct that holds a solve request waiting for a server worker
+struct ServerJob
 {
-    bool operator()(const State* lhs, const State* rhs) const
-    {
-        return (lhs->misplacedTiles) > (rhs->misplacedTiles);
-    }
+    shared_ptr<ServerConnection> connection;    //Holds the client to answer
+    string id;                                  //Holds the client's name for the request
+    Algorithm algorithm;                        //Holds the search to run
+    Board board;                                //Holds the puzzle to solve
+    Board goal;                                 //Holds the puzzle to solve toward
+    double timeLimit;                           //Holds the seconds the search may run
+    size_t maxMemory;                           //Holds the most bytes the search may hold
+    chrono::steady_clock::time_point received;  //Holds when the request was read
 };
 
-// Comparison object to be used to order the heap for Manhattan Distance
-struct mdcomp
+//This is the struct that counts how long the server took to answer, from reading a request
+//to writing its answer. Atomic counters let every worker record without a lock.
+struct LatencyHistogram
 {
-    bool operator()(const State* lhs, const State* rhs) const
-    {
-        return (lhs->manhattanDistance) > (rhs->manhattanDistance);
-    }
+    atomic<uint64_t> buckets[SERVER_HISTOGRAM_BUCKETS];
+    atomic<uint64_t> count;
+    atomic<uint64_t> totalMicroseconds;
+    atomic<uint64_t> maximumMicroseconds;
+    
+    void record(uint64_t);
+    uint64_t percentile(double) const;
+};
+
+//Number of puzzle ranks read or written in one go by the state space enumeration, 1 MB
+#define RANK_BLOCK_SIZE 131072
+
+//Most megabytes --depth-table will allocate. A 4x3 board needs 57 MB, while the next sizes up
+//need hundreds of gigabytes and belong on disk with --enumerate.
+#define TWO_BIT_TABLE_MAX_MB 8192.0
+
+//Most run files the state space enumeration merges at once, well under the usual open file limit
+#define RANK_MERGE_WIDTH 128
+
+//This is the struct that reads a file of puzzle ranks in large blocks, one rank at a time
+struct RankReader
+{
+    FILE* file = NULL;                  //Holds the open file
+    vector<uint64_t> block;             //Holds the ranks read but not handed out yet
+    size_t position = 0;                //Holds the next rank in the block to hand out
+    
+    bool open(const string&);
+    bool next(uint64_t&);
+    bool close();
+};
+
+//This is the struct that writes puzzle ranks to a file in large blocks
+struct RankWriter
+{
+    FILE* file = NULL;                  //Holds the open file
+    vector<uint64_t> block;             //Holds the ranks not written yet
+    uint64_t written = 0;               //Holds the number of ranks written so far
+    
+    bool open(const string&);
+    void write(uint64_t);
+    bool close();
 };
 
 //Function Definitions
@@ -72,80 +155,166 @@ void breadthFirstSearch(int[], fstream&);
 void depthFirstSearch(int[], fstream&);
 void misplacedTilesSearch(int[], fstream&);
 void manhattenDistanceSearch(int[], fstream&);
-void puzzlePrinter(int[], fstream&);
-bool puzzleInputVerifier(int, int, fstream&);
+void puzzlePrinter(const int[], fstream&);
+bool puzzleInputVerifier(int, int, int[], fstream&);
 bool integerVerify(int);
-bool puzzleSolved(int);
-int findEmptySpace(int[]);
 void pressToContinue(fstream&);
-bool moveUp(int);
-bool moveRight(int);
-bool moveDown(int);
-bool moveLeft(int);
-bool listSearch(int);
-int countMisplacedTiles(int[], fstream&);
-void printPath(State*, int, fstream&);
-void tilesPrintPath(State*, int, fstream&);
-void distancePrintPath(State*, int, fstream&);
-bool isSolvable(int[]);
-int getInvCount(int[]);
+void printPath(const vector<State>&, fstream&);
+void tilesPrintPath(const vector<State>&, fstream&);
+void distancePrintPath(const vector<State>&, fstream&);
 void useSameArray(int[], fstream&);
-int getManhattanDistance(int[], fstream&);
-void getRowAndColumn(int[], int, int&, int&);
-int arrayToIntConverter(int[]);
 void puzzleInvalidMenuSwitch(int, int[], fstream&);
 void puzzleInvalidMenu(fstream&, int[]);
+void searchResultReport(SolveResult&, const string&, int[], void (*)(const vector<State>&, fstream&), fstream&);
+void anytimeSearch(int[], fstream&);
+void beamSearch(int[], fstream&);
+void memoryBoundedSearch(int[], fstream&);
+void portfolioSearch(int[], fstream&);
+SolveResult solveWithProgress(int[], Algorithm, Limits, fstream&);
+void printProgress(const SearchProgress&, double, double, fstream&);
+vector<vector<int>> benchmarkCorpus(const string&);
+vector<string> benchmarkCorpusNames();
+size_t peakMemoryUsage();
+int runBenchmark(int, const char*[]);
+int runMicroBenchmark(int, const char*[]);
+int runPuzzleGenerator(int, const char*[]);
+int runStateSpaceEnumeration(int, const char*[]);
+int runTwoBitDepthTable(int, const char*[]);
+bool writeSortedRun(vector<uint64_t>&, const string&);
+bool mergeSortedRuns(const vector<string>&, const vector<string>&, const string&, uint64_t&);
+bool loadBenchmarkBaseline(const string&, vector<BenchmarkRow>&);
+bool saveBenchmarkBaseline(const string&, const vector<BenchmarkRow>&);
+int runSolverServer(int, const char*[]);
+void serverReader(shared_ptr<ServerConnection>);
+void serverWorker();
+void serverSend(ServerConnection&, const string&);
+bool parseServerBoard(const string&, Board&);
+string solutionMoves(const SolveResult&);
+string serverStats();
+
+//Holds the seed of the random puzzle generator
+uint64_t puzzleGeneratorSeed = 0;
+
+//Holds the seconds between progress reports while the menus run a search, 0 for none
+double progressInterval = 0.0;
 
-//Holds the ideal state of the puzzle
-int solvedPuzzle[PUZZLE_LENGTH] = {1,2,3,4,5,6,7,8,0};
+//Holds whether new counts allocations on this thread, and how many it has counted. Only the
+//micro benchmarks turn counting on, and each thread keeps its own count, so no other mode pays
+//for it beyond one test.
+thread_local bool countingAllocations = false;
+thread_local size_t allocationCount = 0;
 
-//Number to hold the user input number and initializing to 9
-int checkArray[PUZZLE_LENGTH] = {9,9,9,9,9,9,9,9,9};
+//Holds the most seconds and bytes any server search may use. A request can ask for less.
+double serverTimeLimit = SERVER_DEFAULT_TIME_LIMIT;
+size_t serverMaxMemory = (size_t) (SERVER_DEFAULT_MEMORY_MB * 1048576.0);
 
-//Creating the linked list.
-list <int> puzzleList;
+//Holds the solve requests waiting for a server worker
+deque<ServerJob> serverJobs;
+mutex serverJobMutex;
+condition_variable serverJobReady;
+
+//Holds how long the server took to answer with each search
+LatencyHistogram serverLatency[MEMORY_BOUNDED + 1];
 
 //----------------------------------------------------------------------
-//newState - Functional to allocate a new node
+//operator new / delete - Replaces the global allocator to count each allocation on the
+//                         threads that have turned counting on
 //----------------------------------------------------------------------
-State* newState(int puzzleArray[], int space, int moveCount, int newSpace, State* parent)
+void* operator new(size_t size)
 {
-    //Creating a new state
-    State* state = new State;
-    
-    //Setting the pointer for the path to the root
-    state->parent = parent;
-    
-    //Copy the state from the parent state to the new state
-    memcpy(state->currentState, puzzleArray, sizeof state->currentState);
-    
-    //Moving the empty space
-    swap(state->currentState[space], state->currentState[newSpace]);
-    
-    //Setting the number of misplaced tiles or manhattenDistance
-    state->misplacedTiles = INT_MAX;
-    
-    //Set the number of moves
-    state->moveCount = moveCount;
+    if(countingAllocations)
+    {
+        allocationCount++;
+    }
     
-    //Updating the location of the new space location
-    state->spaceLocation = newSpace;
+    void* memory = malloc(size == 0 ? 1 : size);
+    if(memory == NULL)
+    {
+        throw bad_alloc();
+    }
     
-    return state;
+    return memory;
+}
+
+//GCC cannot see that the replaced new above uses malloc and warns about the free calls
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    free(memory);
 }
 
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
 //----------------------------------------------------------------------
 //Main - main function
 //----------------------------------------------------------------------
 int main(int argc, const char * argv[])
 {
+    //Running the benchmark suite instead of the menus when requested
+    if(argc > 1 && string(argv[1]) == "--benchmark")
+    {
+        return runBenchmark(argc, argv);
+    }
+    
+    //Running the micro benchmarks instead of the menus when requested
+    if(argc > 1 && string(argv[1]) == "--microbench")
+    {
+        return runMicroBenchmark(argc, argv);
+    }
+    
+    //Writing random puzzles in bulk instead of the menus when requested
+    if(argc > 1 && string(argv[1]) == "--generate")
+    {
+        return runPuzzleGenerator(argc, argv);
+    }
+    
+    //Counting every puzzle at each depth using the disk when requested
+    if(argc > 1 && string(argv[1]) == "--enumerate")
+    {
+        return runStateSpaceEnumeration(argc, argv);
+    }
+    
+    //Counting every puzzle at each depth in memory, two bits a puzzle, when requested
+    if(argc > 1 && string(argv[1]) == "--depth-table")
+    {
+        return runTwoBitDepthTable(argc, argv);
+    }
+    
+    //Answering solve requests over a socket instead of the menus when requested
+    if(argc > 1 && string(argv[1]) == "--serve")
+    {
+        return runSolverServer(argc, argv);
+    }
+    
+    //Printing the search's progress every so often when requested
+    if(argc > 1 && string(argv[1]) == "--progress")
+    {
+        progressInterval = argc > 2 ? atof(argv[2]) : 1.0;
+        if(progressInterval <= 0.0)
+        {
+            cerr << "Usage: SliderPuzzle --progress [SECONDS]\n";
+            return 1;
+        }
+    }
+    
     //Creating new txt file for console output
     fstream outputFile;
     outputFile.open("AI_SliderPuzzle_Output.txt", fstream::out);
     
-    //Time based random number generator for the program.
+    //Time based seed for the puzzle generator.
     //This is in main so it only gets called once and starts upon program run.
-    srand((unsigned int) time(NULL));
+    puzzleGeneratorSeed = (uint64_t) time(NULL) ^ (uint64_t) chrono::steady_clock::now().time_since_epoch().count();
     
     //Welcome message
     welcomeMessage(outputFile);
@@ -235,7 +404,12 @@ void mainMenuSwitch(int mainMenuSwitch, fstream& outputFile)
         }
         case 3://Load a premade puzzle
         {
+#if PUZZLE_WIDTH == 3 && PUZZLE_HEIGHT == 3
             premadePuzzles(outputFile);
+#else
+            cout << "\t::The pre-made puzzles are only for the 3x3 board::\n";
+            puzzleMainMenu(outputFile);
+#endif
             break;
         }
         case 4://Generate a puzzle
@@ -277,6 +451,10 @@ void howToSolveMenu(int puzzleArray[], fstream& outputFile)
     cout << "\t\t2: Depth First Search.\n";
     cout << "\t\t3: A* using Number of Misplaced Tiles .\n";
     cout << "\t\t4: A* using Manhatten Distance.\n";
+    cout << "\t\t5: Anytime Weighted A* with a time limit.\n";
+    cout << "\t\t6: Beam Search with a set width.\n";
+    cout << "\t\t7: A* with a memory limit (SMA*).\n";
+    cout << "\t\t8: Race several searches at once (portfolio).\n";
     cout << "\n\t\t"; //This is a spacer and tab line for the user input so it aligns with the menu
     
     //User enters their selection here.
@@ -329,6 +507,26 @@ void solveMenuSwitch(int solveMenuSelection, int puzzleArray[], fstream& outputF
             manhattenDistanceSearch(puzzleArray, outputFile);
             break;
         }
+        case 5://Anytime weighted A* using the "Manhattan Distance"
+        {
+            anytimeSearch(puzzleArray, outputFile);
+            break;
+        }
+        case 6://Beam search using the "Manhattan Distance"
+        {
+            beamSearch(puzzleArray, outputFile);
+            break;
+        }
+        case 7://Simplified memory bounded A* using the "Manhattan Distance"
+        {
+            memoryBoundedSearch(puzzleArray, outputFile);
+            break;
+        }
+        case 8://Several searches raced against each other
+        {
+            portfolioSearch(puzzleArray, outputFile);
+            break;
+        }
         default://Invalid selection
         {
             cout << "\t::Invalid Selection::\n";
@@ -352,42 +550,35 @@ void puzzleEntry(fstream& outputFile)
     //Variable to hold the users input
     int userInput;
     
-    //Resetting the checkArray to '9' in each slot for use in our numberVerifier
-    for(int x = 0; x < PUZZLE_LENGTH; x++)
+    //Number to hold the user input number and initializing to -1 for use in our numberVerifier
+    int checkArray[PUZZLE_LENGTH];
+    
+    //Numbering the slots for the picture of the puzzle
+    int slotNumbers[PUZZLE_LENGTH];
+    
+    for(int i = 0; i < PUZZLE_LENGTH; i++)
     {
-        checkArray[x] = 9;
+        checkArray[i] = -1;
+        slotNumbers[i] = i + 1;
     }
     
     //Displaying the way the puzzle looks to the user
     cout << "This is the look of the slider puzzle.\n\n";
-    cout << "\t\t_\t_\t_\t_\t_\t_\t_\n";
-    cout << "\t\t|\t1\t|\t2\t|\t3\t|\n";
-    cout << "\t\t|\t-\t-\t-\t-\t-\t|\n";
-    cout << "\t\t|\t4\t|\t5\t|\t6\t|\n";
-    cout << "\t\t|\t-\t-\t-\t-\t-\t|\n";
-    cout << "\t\t|\t7\t|\t8\t|\t9\t|\n";
-    cout << "\t\t-\t-\t-\t-\t-\t-\t-\n\n";
     outputFile << "This is the look of the slider puzzle.\n\n";
-    outputFile << "\t\t_\t_\t_\t_\t_\t_\t_\n";
-    outputFile << "\t\t|\t1\t|\t2\t|\t3\t|\n";
-    outputFile << "\t\t|\t-\t-\t-\t-\t-\t|\n";
-    outputFile << "\t\t|\t4\t|\t5\t|\t6\t|\n";
-    outputFile << "\t\t|\t-\t-\t-\t-\t-\t|\n";
-    outputFile << "\t\t|\t7\t|\t8\t|\t9\t|\n";
-    outputFile << "\t\t-\t-\t-\t-\t-\t-\t-\n\n";
+    puzzlePrinter(slotNumbers, outputFile);
     
     //Asking for user input.
     cout << "Please enter a number as requested.\n";
-    cout << "Acceptable numbers are 1-8, and 0 for\n";
+    cout << "Acceptable numbers are 1-" << PUZZLE_LENGTH - 1 << ", and 0 for\n";
     cout << "the empty slot in the puzzle.\n\n";
     cout << "OR enter 99 to return to the main menu.\n\n";
     outputFile << "Please enter a number as requested.\n";
-    outputFile << "Acceptable numbers are 1-8, and 0 for\n";
+    outputFile << "Acceptable numbers are 1-" << PUZZLE_LENGTH - 1 << ", and 0 for\n";
     outputFile << "the empty slot in the puzzle.\n\n";
     outputFile << "OR enter 99 to return to the main menu.\n\n";
     
     //For loop to recieve the user selection.
-    for (int i = 1; i < 10; i++)
+    for (int i = 1; i <= PUZZLE_LENGTH; i++)
     {
         cout << "Please enter a number for slot " << i << ": ";
         outputFile << "Please enter a number for slot " << i << ": ";
@@ -403,7 +594,7 @@ void puzzleEntry(fstream& outputFile)
         }
         
         //Checking if the userInput is within scope and not previously used.
-        if(puzzleInputVerifier(userInput, option, outputFile))
+        if(puzzleInputVerifier(userInput, option, checkArray, outputFile))
         {
             puzzleArray[i-1] = userInput;
         }
@@ -523,6 +714,7 @@ void puzzleLoader(fstream& outputFile)
     
 }
 
+#if PUZZLE_WIDTH == 3 && PUZZLE_HEIGHT == 3
 //---------------------------------------------------------------------------------------
 //premadePuzzles - This function will print a list of premade puzzles to the user and
 //                 allow the user to select one puzzle for solving.
@@ -670,57 +862,26 @@ void premadePuzzleSwitch(int solveMenuSelection, fstream& outputFile)
     //Calling the solving options
     howToSolveMenu(puzzleArray, outputFile);
 }
+#endif
 
 //---------------------------------------------------------------------------------------
 //puzzleGenerator() - This function randomly generates a puzzle for the user to have solved.
 //---------------------------------------------------------------------------------------
 void puzzleGenerator(fstream& outputFile)
 {
-    //Setting the option to 1
-    int option = 1;
-    
-    //Variable to hold a random number
-    int randomNumber = 0;
-    
-    //Resetting the checkArray to '9' in each slot for use in our numberVerifier
-    for(int x = 0; x < PUZZLE_LENGTH; x++)
-    {
-        checkArray[x] = 9;
-    }
-    
     //Array to hold the puzzle
-    int puzzleArray[PUZZLE_LENGTH] = {9,9,9,9,9,9,9,9,9};
+    int puzzleArray[PUZZLE_LENGTH];
     
     //Notifiying user of random number being generated.
     cout << "Randomly generating a puzzle...\n";
     outputFile << "Randomly generating a puzzle...\n";
     
-    //For loop to fill each slot of the array
-    for(int i = 0; i < PUZZLE_LENGTH; i++)
-    {
-        //Generates random number between 0 and 8
-        randomNumber = rand() % (8 - 0) + 0;
-
-        //Checking if the number is between 0-8 and that it hasnt been used previously.
-        while(!puzzleInputVerifier(randomNumber, option, outputFile))
-        {
-            //Generating another random number
-            randomNumber = rand() % (9 - 0) + 0;
-        }
-        
-        //Setting the location in the array to the randomNumber
-        puzzleArray[i] = randomNumber;
-    }
-    
-    //If the generated puzzle is not solvable, recall the puzzle generator
-    //and try again.
-    if(!isSolvable(puzzleArray))
-    {
-        puzzleGenerator(outputFile);
-    }
+    //Picking one of the solvable puzzles, each one is equally likely
+    randomSolvablePuzzle(puzzleArray, puzzleGeneratorSeed);
     
     //Printing the generated puzzle
     cout << "This is your generated puzzle:\n";
+    outputFile << "This is your generated puzzle:\n";
     puzzlePrinter(puzzleArray, outputFile);
     
     //Sending the generated puzzle to the solve menu
@@ -769,7 +930,7 @@ void exitProgram(fstream& outputFile)
 //---------------------------------------------------------------------------------------
 //puzzleInputVerifier - This is a bool to check if a number entered by the user is used
 //---------------------------------------------------------------------------------------
-bool puzzleInputVerifier(int userInput, int option, fstream& outputFile)
+bool puzzleInputVerifier(int userInput, int option, int checkArray[], fstream& outputFile)
 {
     //Checking if 99 was entered to return to the main menu
     if (userInput == 99)
@@ -777,8 +938,8 @@ bool puzzleInputVerifier(int userInput, int option, fstream& outputFile)
         puzzleMainMenu(outputFile);
     }
     
-    //Making sure the user input is between 0-8
-    if (userInput < 0 || userInput > 8)
+    //Making sure the user input is one of the tiles or the space
+    if (userInput < 0 || userInput > PUZZLE_LENGTH - 1)
     {
         cout << "Input is not within the scope of the puzzle.\n";
         return false;
@@ -803,9 +964,9 @@ bool puzzleInputVerifier(int userInput, int option, fstream& outputFile)
     //Checking each allocation of the array for the userInput amount
     for(int j = 0; j < PUZZLE_LENGTH; j++)
     {
-        //If the slot of the array == 9, then it has not been used and will
+        //If the slot of the array == -1, then it has not been used and will
         //be set to the input number from the user and breaks out of the loop.
-        if(checkArray[j] == 9)
+        if(checkArray[j] == -1)
         {
             checkArray[j] = userInput;
             return true;
@@ -845,9 +1006,56 @@ bool integerVerify(int userInput)
 //---------------------------------------------------------------------------------------
 void breadthFirstSearch(int puzzleArray[], fstream& outputFile)
 {
-    //Starting timer
-    auto start = chrono::system_clock::now();
+    //Running the search, or taking the answer from the cache
+    SolveResult result = solveWithProgress(puzzleArray, BREADTH_FIRST, Limits(), outputFile);
+    
+    //Reporting the result to the user
+    searchResultReport(result, "Breadth First Search", puzzleArray, printPath, outputFile);
+}
+
+//---------------------------------------------------------------------------------------
+//depthFirstSearch - Depth First Search algorithim to solve the puzzle
+//---------------------------------------------------------------------------------------
+void depthFirstSearch(int puzzleArray[], fstream& outputFile)
+{
+    //Running the search, or taking the answer from the cache
+    SolveResult result = solveWithProgress(puzzleArray, DEPTH_FIRST, Limits(), outputFile);
+    
+    //Reporting the result to the user
+    searchResultReport(result, "Depth First Search", puzzleArray, printPath, outputFile);
+}
+
+//---------------------------------------------------------------------------------------
+//misplacedTilesSearch - A* search algorithm using the misplaced tiles method
+//---------------------------------------------------------------------------------------
+void misplacedTilesSearch(int puzzleArray[], fstream& outputFile)
+{
+    //Running the search, or taking the answer from the cache
+    SolveResult result = solveWithProgress(puzzleArray, MISPLACED_TILES, Limits(), outputFile);
+    
+    //Reporting the result to the user
+    searchResultReport(result, "Misplaced Tiles Search", puzzleArray, tilesPrintPath, outputFile);
+}
+
+//---------------------------------------------------------------------------------------
+//manhattenDistanceSearch - A* search algorithm using the "Manhatten Distance" method
+//---------------------------------------------------------------------------------------
+void manhattenDistanceSearch(int puzzleArray[], fstream& outputFile)
+{
+    //Running the search, or taking the answer from the cache
+    SolveResult result = solveWithProgress(puzzleArray, MANHATTAN_DISTANCE, Limits(), outputFile);
     
+    //Reporting the result to the user
+    searchResultReport(result, "Manhatten Distance Search", puzzleArray, distancePrintPath, outputFile);
+}
+
+//---------------------------------------------------------------------------------------
+//searchResultReport - Prints the outcome of a search, offers to print each move and then
+//                     asks the user if they want to use the same puzzle again.
+//---------------------------------------------------------------------------------------
+void searchResultReport(SolveResult& result, const string& searchName, int puzzleArray[],
+                        void (*pathPrinter)(const vector<State>&, fstream&), fstream& outputFile)
+{
     //Saving the starting puzzle
     int startingPuzzle[PUZZLE_LENGTH];
     for(int q = 0; q < PUZZLE_LENGTH; q++)
@@ -855,789 +1063,358 @@ void breadthFirstSearch(int puzzleArray[], fstream& outputFile)
         startingPuzzle[q] = puzzleArray[q];
     }
     
-    //Variable to count the total number of nodes created
-    int totalNodeCount = 0;
+    //Letting the user know the search was not run again
+    if(result.fromCache)
+    {
+        cout << "\nThis puzzle was already solved with this search, using the saved answer.\n";
+        cout << "Cache hits: " << solutionCache.hits << "  Cache misses: " << solutionCache.misses << endl;
+        outputFile << "\nThis puzzle was already solved with this search, using the saved answer.\n";
+    }
+    
+    //Letting the user know the search was stopped by one of its limits
+    if(result.stopReason != NOT_STOPPED)
+    {
+        cout << "\nThe search was stopped early: " << stopReasonName(result.stopReason) << ".\n";
+        outputFile << "\nThe search was stopped early: " << stopReasonName(result.stopReason) << ".\n";
+    }
     
-    //Creating the stack
-    queue<State*> BFSqueue;
+    //Letting the user know the search ran out of memory and had to forget nodes
+    if(result.forgottenNodes > 0)
+    {
+        cout << "\nThe memory limit was reached, " << result.forgottenNodes << " nodes were forgotten and searched again.\n";
+        outputFile << "\nThe memory limit was reached, " << result.forgottenNodes << " nodes were forgotten and searched again.\n";
+    }
     
-    //Variable to hold the return value from the function that finds the empty space
-    int startingEmptySpaceLocation = findEmptySpace(puzzleArray);
+    //NO SOLUTION FOUND
+    if(!result.solved)
+    {
+        cout << "\nNo Solution Found." << endl;
+    }
     
-    //Creating a newNode with the necessary information
-    State* startingState = newState(puzzleArray, startingEmptySpaceLocation, 0, startingEmptySpaceLocation, NULL);
+    //Notifying user of the time it took to complete the sorting.
+    cout << "\n" << searchName << " Elapsed time: " << result.elapsedTime << "s\n\n";
+    outputFile << "\n" << searchName << " Elapsed time: " << result.elapsedTime << "s\n\n";
     
-    //Pushing the startingState struct onto the queue
-    BFSqueue.push(startingState);
+    //Printing the total nodes count.
+    cout << "\t\tTotal Nodes Created: " << result.totalNodeCount << endl << endl;
+    outputFile << "\t\tTotal Nodes Created: " << result.totalNodeCount << endl << endl;
     
-    //While the stack is not empty, run this
-    while(!BFSqueue.empty())
+    if(result.solved)
     {
-        //Setting the working puzzle to the puzzle that is on the top of the stack
-        State* tempPuzzle = BFSqueue.front();
-        
-        //If the current state we are checking is not equal to the goal state
-        //pop off the front cell in the queue and queue its possible moves.
-        BFSqueue.pop();
-        totalNodeCount++;
-        
-        //Checking if the current state of the puzzle is the ideal state (SOLVED)
-        if(puzzleSolved(arrayToIntConverter(tempPuzzle->currentState)))
-        {
-            //Deleting the queue
-            while (!BFSqueue.empty())
-            {
-                BFSqueue.pop();
-                totalNodeCount++;
-            }
-            
-            //Stopping timer
-            auto end = chrono::system_clock::now();
-            
-            //Getting the total elapsed time: End time - Start time = Total time elapsed.
-            chrono::duration<double> elapsedTime = (end - start);
-            
-            //Notifying user of the time it took to complete the sorting.
-            cout << "\nBreadth First Search Elapsed time: " << elapsedTime.count() << "s\n\n";
-            outputFile << "\nBreadth First Search Elapsed time: " << elapsedTime.count() << "s\n\n";
-            
-            //Printing the total nodes count.
-            cout << "\t\tTotal Nodes Created: " << totalNodeCount << endl << endl;
-            outputFile << "\t\tTotal Nodes Created: " << totalNodeCount << endl << endl;
-            
-            //Printing the move count.
-            cout << "\t\tTotal Moves: " << tempPuzzle->moveCount << endl << endl;
-            outputFile << "\t\tTotal Moves: " << tempPuzzle->moveCount << endl << endl;
-            
-            //Printing the final puzzle
-            puzzlePrinter(tempPuzzle->currentState, outputFile);
-            
-            //Asking the user if they want to see each move that was taken
-            char decision = NULL;
-            cout << "\tWould you like to see all the moves used?\n";
-            cout << "\tEnter Y for yes or N for no.\n";
-            cout << "\tDecision:";
-            cin >> decision;
-            cout << endl << endl;
-            
-            //Verifies input is Y or N. IF NOT, requests new input
-            while(decision != 'Y' && decision != 'y' && decision != 'N' && decision != 'n' )
-            {
-                cout << "\nPlease enter a correct selection.\n";
-                cout << "Enter Here:  ";
-                cin >> decision;
-            }
-            
-            //If the user enters "y" or "Y" then call the printPath function
-            if(decision == 'y' || decision == 'Y')
-            {
-                outputFile << "Printing each move from start to finish.\n\n";
-                printPath(tempPuzzle, tempPuzzle->moveCount, outputFile);
-                cout << endl << endl;
-            }
-            
-            //Clearing the list
-            puzzleList.clear();
-            
-            //Asking the user if they want to use the same array for a different search, if they do not
-            //this function will send them back to the main menu.
-            useSameArray(startingPuzzle, outputFile);
-        }
+        //Printing the move count.
+        cout << "\t\tTotal Moves: " << result.path.size() - 1 << endl << endl;
+        outputFile << "\t\tTotal Moves: " << result.path.size() - 1 << endl << endl;
         
-        //Checking if the space can move up, if yes, swaps locations, increments the counter,
-        //and pop the new puzzle onto the stack
-        if (moveUp(tempPuzzle->spaceLocation) && !listSearch(arrayToIntConverter(tempPuzzle->currentState)))
-        {
-            //Creating the new state
-            State* child = newState(tempPuzzle->currentState, tempPuzzle->spaceLocation, tempPuzzle->moveCount + 1, tempPuzzle->spaceLocation - 3, tempPuzzle);
-            
-            //Pushing the tempPuzzle onto the stack
-            BFSqueue.push(child);
-        }
+        //Printing the final puzzle
+        puzzlePrinter(result.path.back().currentState, outputFile);
         
-        //Checking if the space can move right, if yes, swaps locations, increments the counter,
-        //and pop the new puzzle onto the stack
-        if (moveRight(tempPuzzle->spaceLocation) && !listSearch(arrayToIntConverter(tempPuzzle->currentState)))
-        {
-            //Creating the new state
-            State* child = newState(tempPuzzle->currentState, tempPuzzle->spaceLocation, tempPuzzle->moveCount + 1, tempPuzzle->spaceLocation + 1, tempPuzzle);
-            
-            //Pushing the tempPuzzle onto the stack
-            BFSqueue.push(child);
-        }
+        //Asking the user if they want to see each move that was taken
+        char decision = 0;
+        cout << "\tWould you like to see all the moves used?\n";
+        cout << "\tEnter Y for Yes or N for No.\n";
+        cout << "\tDecision:";
+        cin >> decision;
+        cout << endl << endl;
         
-        //Checking if the space can move down, if yes, swaps locations, increments the counter,
-        //and pop the new puzzle onto the stack
-        if (moveDown(tempPuzzle->spaceLocation) && !listSearch(arrayToIntConverter(tempPuzzle->currentState)))
+        //Verifies input is Y or N. IF NOT, requests new input
+        while(decision != 'Y' && decision != 'y' && decision != 'N' && decision != 'n' )
         {
-            //Creating the new state
-            State* child = newState(tempPuzzle->currentState, tempPuzzle->spaceLocation, tempPuzzle->moveCount + 1, tempPuzzle->spaceLocation + 3, tempPuzzle);
-            
-            //Pushing the tempPuzzle onto the stack
-            BFSqueue.push(child);
+            cout << "\nPlease enter a correct selection.\n";
+            cout << "Enter Here:  ";
+            cin >> decision;
         }
         
-        //Checking if the space can move left, if yes, swaps locations, increments the counter,
-        //and pop the new puzzle onto the stack
-        if (moveLeft(tempPuzzle->spaceLocation) && !listSearch(arrayToIntConverter(tempPuzzle->currentState)))
+        //If the user enters "y" or "Y" then call the path printer
+        if(decision == 'y' || decision == 'Y')
         {
-            //Creating the new state
-            State* child = newState(tempPuzzle->currentState, tempPuzzle->spaceLocation, tempPuzzle->moveCount + 1, tempPuzzle->spaceLocation - 1, tempPuzzle);
-            
-            //Pushing the tempPuzzle onto the stack
-            BFSqueue.push(child);
+            outputFile << "Printing each move from start to finish.\n\n";
+            pathPrinter(result.path, outputFile);
+            cout << endl << endl;
         }
-        
-        //Adding the tempPuzzle to the List
-        puzzleList.push_front(arrayToIntConverter(tempPuzzle->currentState));
     }
     
-    //NO SOLUTION FOUND
-    cout << "\nNo Solution Found." << endl;
-    
-    //Stopping timer
-    auto end = chrono::system_clock::now();
-    
-    //Getting the total elapsed time: End time - Start time = Total time elapsed.
-    chrono::duration<double> elapsedTime = (end - start);
-    
-    //Notifying user of the time it took to complete the sorting.
-    cout << "\nBreadth First Search Elapsed time: " << elapsedTime.count() << "s\n\n";
-    outputFile << "\nBreadth First Search Elapsed time: " << elapsedTime.count() << "s\n\n";
-    
-    //Printing the total nodes count.
-    cout << "\t\tTotal Nodes Created: " << totalNodeCount << endl << endl;
-    outputFile << "\t\tTotal Nodes Created: " << totalNodeCount << endl << endl;
-    
-    //Clearing the list
-    puzzleList.clear();
-    
     //Asking the user if they want to use the same array for a different search, if they do not
     //this function will send them back to the main menu.
     useSameArray(startingPuzzle, outputFile);
 }
 
 //---------------------------------------------------------------------------------------
-//depthFirstSearch - Depth First Search algorithim to solve the puzzle
+//anytimeSearch - Anytime weighted A* search that improves its solution until the time limit
+//                the user enters runs out
 //---------------------------------------------------------------------------------------
-void depthFirstSearch(int puzzleArray[], fstream& outputFile)
+void anytimeSearch(int puzzleArray[], fstream& outputFile)
 {
-    //Starting timer
-    auto start = chrono::system_clock::now();
+    //Variable to hold the time limit
+    double timeBudget = 0.0;
     
-    //Saving the starting puzzle
-    int startingPuzzle[PUZZLE_LENGTH];
-    for(int q = 0; q < PUZZLE_LENGTH; q++)
+    cout << "Please enter the time limit in seconds: ";
+    cin >> timeBudget;
+    
+    //Verifies input is a number. IF NOT, requests new input
+    while(!integerVerify((int) timeBudget) || timeBudget <= 0.0)
     {
-        startingPuzzle[q] = puzzleArray[q];
+        cout << "Please Enter a Time Limit: ";
+        cin >> timeBudget;
     }
     
-    //Variable to count the total number of nodes created
-    int totalNodeCount = 0;
-    
-    //Creating the stack
-    stack<State*> DFSstack;
-    
-    //Variable to hold the return value from the function that finds the empty space
-    int startingEmptySpaceLocation = findEmptySpace(puzzleArray);
-    
-    //Creating a newNode with the necessary information
-    State* startingState = newState(puzzleArray, startingEmptySpaceLocation, 0, startingEmptySpaceLocation, NULL);
+    outputFile << "Time limit: " << timeBudget << "s\n\n";
+    cout << endl;
     
-    //Pushing the startingState struct onto the queue
-    DFSstack.push(startingState);
+    //Running the search
+    Limits limits;
+    limits.timeLimit = timeBudget;
+    SolveResult result = solveWithProgress(puzzleArray, ANYTIME_WEIGHTED, limits, outputFile);
     
-    //While the stack is not empty, run this
-    while(!DFSstack.empty())
+    //Printing each improved solution the search found
+    for(const AnytimeStage& stage : result.anytimeStages)
     {
-        //Setting the working puzzle to the puzzle that is on the top of the stack
-        State* tempPuzzle = DFSstack.top();
-        
-        //If the current state we are checking is not equal to the goal state
-        //pop off the front cell in the queue and queue its possible moves.
-        DFSstack.pop();
-        totalNodeCount++;
-        
-        //Checking if the current state of the puzzle is the ideal state (SOLVED)
-        if(puzzleSolved(arrayToIntConverter(tempPuzzle->currentState)))
-        {
-            //Deleting the stack
-            while (!DFSstack.empty())
-            {
-                DFSstack.pop();
-                totalNodeCount++;
-            }
-            
-            //Stopping timer
-            auto end = chrono::system_clock::now();
-            
-            //Getting the total elapsed time: End time - Start time = Total time elapsed.
-            chrono::duration<double> elapsedTime = (end - start);
-            
-            //Notifying user of the time it took to complete the sorting.
-            cout << "\nDepth First Search Elapsed time: " << elapsedTime.count() << "s\n\n";
-            outputFile << "\nDepth First Search Elapsed time: " << elapsedTime.count() << "s\n\n";
-            
-            //Printing the total nodes count.
-            cout << "\t\tTotal Nodes Created: " << totalNodeCount << endl << endl;
-            outputFile << "\t\tTotal Nodes Created: " << totalNodeCount << endl << endl;
-            
-            //Printing the move count.
-            cout << "\t\tTotal Moves: " << tempPuzzle->moveCount << endl << endl;
-            outputFile << "\t\tTotal Moves: " << tempPuzzle->moveCount << endl << endl;
-            
-            //Printing the final puzzle
-            puzzlePrinter(tempPuzzle->currentState, outputFile);
-            
-            //Asking the user if they want to see each move that was taken
-            char decision = NULL;
-            cout << "\tWould you like to see all the moves used?\n";
-            cout << "\tEnter Y for yes or N for no.\n";
-            cout << "\tDecision:";
-            cin >> decision;
-            cout << endl << endl;
-            
-            //Verifies input is Y or N. IF NOT, requests new input
-            while(decision != 'Y' && decision != 'y' && decision != 'N' && decision != 'n' )
-            {
-                cout << "\nPlease enter a correct selection.\n";
-                cout << "Enter Here:  ";
-                cin >> decision;
-            }
-            
-            //If the user enters "y" or "Y" then call the printPath function
-            if(decision == 'y' || decision == 'Y')
-            {
-                outputFile << "Printing each move from start to finish.\n\n";
-                printPath(tempPuzzle, tempPuzzle->moveCount, outputFile);
-                cout << endl << endl;
-            }
-            
-            //Clearing the list
-            puzzleList.clear();
-            
-            //Asking the user if they want to use the same array for a different search, if they do not
-            //this function will send them back to the main menu.
-            useSameArray(startingPuzzle, outputFile);
-        }
-        
-        //Checking if the space can move up, if yes, swaps locations, increments the counter,
-        //and pop the new puzzle onto the stack
-        if (moveUp(tempPuzzle->spaceLocation) && !listSearch(arrayToIntConverter(tempPuzzle->currentState)))
-        {
-            //Creating the new state
-            State* child = newState(tempPuzzle->currentState, tempPuzzle->spaceLocation, tempPuzzle->moveCount + 1, tempPuzzle->spaceLocation - 3, tempPuzzle);
-            
-            //Pushing the tempPuzzle onto the stack
-            DFSstack.push(child);
-        }
-        
-        //Checking if the space can move right, if yes, swaps locations, increments the counter,
-        //and pop the new puzzle onto the stack
-        if (moveRight(tempPuzzle->spaceLocation) && !listSearch(arrayToIntConverter(tempPuzzle->currentState)))
-        {
-            //Creating the new state
-            State* child = newState(tempPuzzle->currentState, tempPuzzle->spaceLocation, tempPuzzle->moveCount + 1, tempPuzzle->spaceLocation + 1, tempPuzzle);
-            
-            //Pushing the tempPuzzle onto the stack
-            DFSstack.push(child);
-        }
-        
-        //Checking if the space can move down, if yes, swaps locations, increments the counter,
-        //and pop the new puzzle onto the stack
-        if (moveDown(tempPuzzle->spaceLocation) && !listSearch(arrayToIntConverter(tempPuzzle->currentState)))
-        {
-            //Creating the new state
-            State* child = newState(tempPuzzle->currentState, tempPuzzle->spaceLocation, tempPuzzle->moveCount + 1, tempPuzzle->spaceLocation + 3, tempPuzzle);
-            
-            //Pushing the tempPuzzle onto the stack
-            DFSstack.push(child);
-        }
-        
-        //Checking if the space can move left, if yes, swaps locations, increments the counter,
-        //and pop the new puzzle onto the stack
-        if (moveLeft(tempPuzzle->spaceLocation) && !listSearch(arrayToIntConverter(tempPuzzle->currentState)))
-        {
-            //Creating the new state
-            State* child = newState(tempPuzzle->currentState, tempPuzzle->spaceLocation, tempPuzzle->moveCount + 1, tempPuzzle->spaceLocation - 1, tempPuzzle);
-            
-            //Pushing the tempPuzzle onto the stack
-            DFSstack.push(child);
-        }
-        
-        //Adding the tempPuzzle to the List
-        puzzleList.push_front(arrayToIntConverter(tempPuzzle->currentState));
+        cout << "\tWeight " << stage.weight << ": " << stage.solutionLength << " moves, at most "
+             << stage.bound << " times optimal (" << stage.elapsedTime << "s, "
+             << stage.expandedNodes << " nodes expanded)\n";
+        outputFile << "\tWeight " << stage.weight << ": " << stage.solutionLength << " moves, at most "
+                   << stage.bound << " times optimal (" << stage.elapsedTime << "s, "
+                   << stage.expandedNodes << " nodes expanded)\n";
     }
     
-    //NO SOLUTION FOUND
-    cout << "\nNo Solution Found." << endl;
-    
-    //Stopping timer
-    auto end = chrono::system_clock::now();
+    //Reporting the result to the user
+    searchResultReport(result, "Anytime Weighted A* Search", puzzleArray, distancePrintPath, outputFile);
+}
+
+//---------------------------------------------------------------------------------------
+//beamSearch - Beam search that keeps the number of nodes per layer the user enters
+//---------------------------------------------------------------------------------------
+void beamSearch(int puzzleArray[], fstream& outputFile)
+{
+    //Variable to hold the beam width
+    int beamWidth = 0;
     
-    //Getting the total elapsed time: End time - Start time = Total time elapsed.
-    chrono::duration<double> elapsedTime = (end - start);
+    cout << "Please enter the number of nodes to keep per layer: ";
+    cin >> beamWidth;
     
-    //Notifying user of the time it took to complete the sorting.
-    cout << "\nDepth First Search Elapsed time: " << elapsedTime.count() << "s\n\n";
-    outputFile << "\nDepth First Search Elapsed time: " << elapsedTime.count() << "s\n\n";
+    //Verifies input is an integer. IF NOT, requests new input
+    while(!integerVerify(beamWidth) || beamWidth < 1)
+    {
+        cout << "Please Enter a Width: ";
+        cin >> beamWidth;
+    }
     
-    //Printing the total nodes count.
-    cout << "\t\tTotal Nodes Created: " << totalNodeCount << endl << endl;
-    outputFile << "\t\tTotal Nodes Created: " << totalNodeCount << endl << endl;
+    outputFile << "Beam width: " << beamWidth << "\n\n";
+    cout << endl;
     
-    //Clearing the list
-    puzzleList.clear();
+    //Running the search
+    Limits limits;
+    limits.beamWidth = beamWidth;
+    SolveResult result = solveWithProgress(puzzleArray, BEAM, limits, outputFile);
     
-    //Asking the user if they want to use the same array for a different search, if they do not
-    //this function will send them back to the main menu.
-    useSameArray(startingPuzzle, outputFile);
+    //Reporting the result to the user
+    searchResultReport(result, "Beam Search", puzzleArray, distancePrintPath, outputFile);
 }
 
 //---------------------------------------------------------------------------------------
-//misplacedTilesSearch - A* search algorithm using the misplaced tiles method
+//memoryBoundedSearch - A* search that never holds more nodes than the limit the user enters
 //---------------------------------------------------------------------------------------
-void misplacedTilesSearch(int puzzleArray[], fstream& outputFile)
+void memoryBoundedSearch(int puzzleArray[], fstream& outputFile)
 {
+    //Variable to hold the node limit
+    int nodeBudget = 0;
     
-    //Starting timer
-    auto start = chrono::system_clock::now();
+    cout << "Please enter the most nodes the search may hold: ";
+    cin >> nodeBudget;
     
-    //Variable to count the total number of nodes created
-    int totalNodeCount = 0;
-    
-    //Saving the starting puzzle
-    int startingPuzzle[PUZZLE_LENGTH];
-    for(int q = 0; q < PUZZLE_LENGTH; q++)
+    //Verifies input is an integer. IF NOT, requests new input
+    while(!integerVerify(nodeBudget) || nodeBudget < 2)
     {
-        startingPuzzle[q] = puzzleArray[q];
+        cout << "Please Enter a Node Limit: ";
+        cin >> nodeBudget;
     }
     
-    //Creating the priority queue
-    priority_queue<State*, vector<State*>, comp> pQueue;
+    outputFile << "Node limit: " << nodeBudget << "\n\n";
+    cout << endl;
+    
+    //Running the search
+    Limits limits;
+    limits.nodeLimit = nodeBudget;
+    SolveResult result = solveWithProgress(puzzleArray, MEMORY_BOUNDED, limits, outputFile);
     
-    //Variable to hold the return value from the function that finds the empty space
-    int startingEmptySpaceLocation = findEmptySpace(puzzleArray);
+    //Reporting the result to the user
+    searchResultReport(result, "Memory Bounded A* Search", puzzleArray, distancePrintPath, outputFile);
+}
+
+//---------------------------------------------------------------------------------------
+//portfolioSearch - Races the default portfolio of searches and reports the first good
+//                  enough answer, then how often each search has won so far
+//---------------------------------------------------------------------------------------
+void portfolioSearch(int puzzleArray[], fstream& outputFile)
+{
+    //Variable to hold the quality selection
+    int qualitySelection = 0;
+    
+    cout << "Please select the solution wanted.\n\n";
+    cout << "\t\t1: Any solution, the first one found.\n";
+    cout << "\t\t2: The shortest solution.\n";
+    cout << "\n\t\tSelection: ";
+    cin >> qualitySelection;
     
-    //Creating a newNode with the necessary information
-    State* startingState = newState(puzzleArray, startingEmptySpaceLocation, 0, startingEmptySpaceLocation, NULL);
+    //Verifies input is an integer. IF NOT, requests new input
+    while(!integerVerify(qualitySelection) || qualitySelection < 1 || qualitySelection > 2)
+    {
+        cout << "Please Enter a Selection: ";
+        cin >> qualitySelection;
+    }
     
-    //Setting the number of misplacedTiles in the startingState to the return value
-    //of the function that counts the number of misplaced tiles
-    startingState->misplacedTiles = countMisplacedTiles(puzzleArray, outputFile);
+    SolutionQuality quality = qualitySelection == 2 ? OPTIMAL_SOLUTION : ANY_SOLUTION;
+    outputFile << "Solution wanted: " << (quality == OPTIMAL_SOLUTION ? "shortest" : "any") << "\n\n";
+    cout << endl;
     
-    //Pushing the startingState struct onto the queue
-    pQueue.push(startingState);
+    //Running the race
+    SolveResult result = solvePortfolio(makeBoard(puzzleArray), defaultPortfolio, quality);
     
-    //Finds a live state with the least number of misplaced tiles,
-    //Adds its children to the list of live states to check, then deletes it from the list
-    while(!pQueue.empty())
+    //Printing how each search has done in the races so far
+    ostringstream stats;
+    stats << "\tPortfolio wins so far:\n";
+    for(int a = 0; a <= MEMORY_BOUNDED; a++)
     {
-        //Creating a temporary state to hold the state with the least number of misplaced tiles from the
-        //top of the queue
-        State* leastTiles = pQueue.top();
-        
-        //Popping the top off the queue and incrementing the totalNodeCount
-        pQueue.pop();
-        totalNodeCount++;
-        
-        //If all the tiles are in the correct location, we have reached the solved puzzle
-        if (puzzleSolved(arrayToIntConverter(leastTiles->currentState)))
+        long races = portfolioStats.races[a].load(memory_order_relaxed);
+        long wins = portfolioStats.wins[a].load(memory_order_relaxed);
+        if(races > 0)
         {
-            //Clearing the Priority Queue
-            while (!pQueue.empty())
-            {
-                pQueue.pop();
-                totalNodeCount++;
-            }
-            
-            //Stopping timer
-            auto end = chrono::system_clock::now();
-            
-            //Getting the total elapsed time: End time - Start time = Total time elapsed.
-            chrono::duration<double> elapsedTime = (end - start);
-            
-            //Notifying user of the time it took to complete the sorting.
-            cout << "\nMisplaced Tiles Search Elapsed time: " << elapsedTime.count() << "s\n\n";
-            outputFile << "\nMispalced Tiles Search Elapsed time: " << elapsedTime.count() << "s\n\n";
-            
-            //Printing the total nodes count.
-            cout << "\t\tTotal Nodes Created: " << totalNodeCount << endl << endl;
-            outputFile << "\t\tTotal Nodes Created: " << totalNodeCount << endl << endl;
-            
-            //Printing the move count.
-            cout << "\t\tTotal Moves: " << leastTiles->moveCount << endl << endl;
-            outputFile << "\t\tTotal Moves: " << leastTiles->moveCount << endl << endl;
-            
-            //Printing the final puzzle
-            puzzlePrinter(leastTiles->currentState, outputFile);
-            
-            //Asking the user if they want to see each move that was taken
-            char decision = NULL;
-            cout << "\tWould you like to see all the moves used?\n";
-            cout << "\tEnter Y for Yes or N for No.\n";
-            cout << "\tDecision:";
-            cin >> decision;
-            cout << endl << endl;
-            
-            //Verifies input is Y or N. IF NOT, requests new input
-            while(decision != 'Y' && decision != 'y' && decision != 'N' && decision != 'n' )
-            {
-                cout << "\nPlease enter a correct selection.\n";
-                cout << "Enter Here:  ";
-                cin >> decision;
-            }
-            
-            //If the user enters "y" or "Y" then call the printPath function
-            if(decision == 'y' || decision == 'Y')
+            stats << "\t\t" << left << setw(10) << solverTable[a].name << right << wins << " of " << races << " races";
+            if(wins > 0)
             {
-                outputFile << "Printing each move from start to finish.\n\n";
-                tilesPrintPath(leastTiles, leastTiles->moveCount, outputFile);
-                cout << endl << endl;
+                stats << ", " << fixed << setprecision(3) << portfolioStats.winMicroseconds[a].load(memory_order_relaxed) / 1000.0 / wins << " ms per win";
             }
-            
-            //Clearing the list
-            puzzleList.clear();
-            
-            //Asking the user if they want to use the same array for a different search, if they do not
-            //this function will send them back to the main menu.
-            useSameArray(startingPuzzle, outputFile);
-        }
-        
-        //-----------ELSE--------------
-        
-        //Checking if the space can move up, if yes, swaps locations, increments the counter,
-        //and pop the new puzzle onto the stack
-        if (moveUp(leastTiles->spaceLocation) && !listSearch(arrayToIntConverter(leastTiles->currentState)))
-        {
-            //Creating the new state
-            State* child = newState(leastTiles->currentState, leastTiles->spaceLocation, leastTiles->moveCount + 1, leastTiles->spaceLocation - 3, leastTiles);
-            
-            //Calculate the number of misplaced tiles for the child and store it in the state
-            child->misplacedTiles = countMisplacedTiles(child->currentState, outputFile);
-            
-            //Pushing the tempPuzzle onto the stack
-            pQueue.push(child);
-        }
-        
-        //Checking if the space can move right, if yes, swaps locations, increments the counter,
-        //and pop the new puzzle onto the stack
-        if (moveRight(leastTiles->spaceLocation) && !listSearch(arrayToIntConverter(leastTiles->currentState)))
-        {
-            //Creating the new state
-            State* child = newState(leastTiles->currentState, leastTiles->spaceLocation, leastTiles->moveCount + 1, leastTiles->spaceLocation + 1, leastTiles);
-            
-            //Calculate the number of misplaced tiles for the child and store it in the state
-            child->misplacedTiles = countMisplacedTiles(child->currentState, outputFile);
-            
-            //Pushing the tempPuzzle onto the stack
-            pQueue.push(child);
-        }
-        
-        //Checking if the space can move down, if yes, swaps locations, increments the counter,
-        //and pop the new puzzle onto the stack
-        if (moveDown(leastTiles->spaceLocation) && !listSearch(arrayToIntConverter(leastTiles->currentState)))
-        {
-            //Creating the new state
-            State* child = newState(leastTiles->currentState, leastTiles->spaceLocation, leastTiles->moveCount + 1, leastTiles->spaceLocation + 3, leastTiles);
-            
-            //Calculate the number of misplaced tiles for the child and store it in the state
-            child->misplacedTiles = countMisplacedTiles(child->currentState, outputFile);
-            
-            //Pushing the tempPuzzle onto the stack
-            pQueue.push(child);
-        }
-        
-        //Checking if the space can move left, if yes, swaps locations, increments the counter,
-        //and pop the new puzzle onto the stack
-        if (moveLeft(leastTiles->spaceLocation) && !listSearch(arrayToIntConverter(leastTiles->currentState)))
-        {
-            //Creating the new state
-            State* child = newState(leastTiles->currentState, leastTiles->spaceLocation, leastTiles->moveCount + 1, leastTiles->spaceLocation - 1, leastTiles);
-            
-            //Calculate the number of misplaced tiles for the child and store it in the state
-            child->misplacedTiles = countMisplacedTiles(child->currentState, outputFile);
-            
-            //Pushing the tempPuzzle onto the stack
-            pQueue.push(child);
+            stats << "\n";
         }
-        
-        //Adding the tempPuzzle to the List
-        puzzleList.push_front(arrayToIntConverter(leastTiles->currentState));
     }
-    //NO SOLUTION FOUND
-    cout << "\nNo Solution Found." << endl;
-    
-    //Stopping timer
-    auto end = chrono::system_clock::now();
-    
-    //Getting the total elapsed time: End time - Start time = Total time elapsed.
-    chrono::duration<double> elapsedTime = (end - start);
+    stats << "\n";
+    cout << stats.str();
+    outputFile << stats.str();
     
-    //Notifying user of the time it took to complete the sorting.
-    cout << "\nMisplaced Tiles Search Elapsed time: " << elapsedTime.count() << "s\n\n";
-    outputFile << "\nMispalced Tiles Search Elapsed time: " << elapsedTime.count() << "s\n\n";
-    
-    //Printing the total nodes count.
-    cout << "\t\tTotal Nodes Created: " << totalNodeCount << endl << endl;
-    outputFile << "\t\tTotal Nodes Created: " << totalNodeCount << endl << endl;
-    
-    //Clearing the list
-    puzzleList.clear();
-    
-    //Asking the user if they want to use the same array for a different search, if they do not
-    //this function will send them back to the main menu.
-    useSameArray(startingPuzzle, outputFile);
+    //Reporting the result to the user
+    searchResultReport(result, string("Portfolio Search (won by ") + solverTable[result.algorithm].name + ")", puzzleArray, printPath, outputFile);
 }
 
 //---------------------------------------------------------------------------------------
-//manhattenDistanceSearch - A* search algorithm using the "Manhatten Distance" method
+//solveWithProgress - Runs a search for the menus. With --progress a second thread prints
+//                    the search's counters every progressInterval seconds until it ends.
 //---------------------------------------------------------------------------------------
-void manhattenDistanceSearch(int puzzleArray[], fstream& outputFile)
+SolveResult solveWithProgress(int puzzleArray[], Algorithm algorithm, Limits limits, fstream& outputFile)
 {
-    //Starting timer
-    auto start = chrono::system_clock::now();
-    
-    //Variable to count the total number of nodes created
-    int totalNodeCount = 0;
-    
-    //Saving the starting puzzle
-    int startingPuzzle[PUZZLE_LENGTH];
-    for(int q = 0; q < PUZZLE_LENGTH; q++)
+    if(progressInterval <= 0.0)
     {
-        startingPuzzle[q] = puzzleArray[q];
+        return solve(makeBoard(puzzleArray), algorithm, limits);
     }
     
-    //Creating the priority queue
-    priority_queue<State*, vector<State*>, mdcomp> mdQueue;
+    //Holds the counters the search publishes, and the signal that it has finished
+    SearchProgress progress;
+    limits.progress = &progress;
+    mutex reporterMutex;
+    condition_variable searchFinished;
+    bool finished = false;
     
-    //Variable to hold the return value from the function that finds the empty space
-    int startingEmptySpaceLocation = findEmptySpace(puzzleArray);
-    
-    //Creating a newNode with the necessary information
-    State* startingState = newState(puzzleArray, startingEmptySpaceLocation, 0, startingEmptySpaceLocation, NULL);
-    
-    //Pushing the startingState struct onto the queue
-    mdQueue.push(startingState);
-    
-    //Finds a live state with the least number of misplaced tiles,
-    //Adds its children to the list of live states to check, then deletes it from the list
-    while(!mdQueue.empty())
+    thread reporter([&]
     {
-        //Creating a temporary state to hold the state with the least number of misplaced tiles from the
-        //top of the queue
-        State* tempPuzzle = mdQueue.top();
-        
-        //Popping the top off the queue and incrementing the totalNodeCount
-        mdQueue.pop();
-        totalNodeCount++;
-        
-        //If all the tiles are in the correct location, we have reached the solved puzzle
-        if (puzzleSolved(arrayToIntConverter(tempPuzzle->currentState)))
-        {
-            //Clearing the Priority Queue
-            while (!mdQueue.empty())
-            {
-                mdQueue.pop();
-                totalNodeCount++;
-            }
-            
-            //Stopping timer
-            auto end = chrono::system_clock::now();
-            
-            //Getting the total elapsed time: End time - Start time = Total time elapsed.
-            chrono::duration<double> elapsedTime = (end - start);
-            
-            //Notifying user of the time it took to complete the sorting.
-            cout << "\nManhatten Distance Search Elapsed time: " << elapsedTime.count() << "s\n\n";
-            outputFile << "\nManhatten Distance Search Elapsed time: " << elapsedTime.count() << "s\n\n";
-            
-            //Printing the total nodes count.
-            cout << "\t\tTotal Nodes Created: " << totalNodeCount << endl << endl;
-            outputFile << "\t\tTotal Nodes Created: " << totalNodeCount << endl << endl;
-            
-            //Printing the move count.
-            cout << "\t\tTotal Moves: " << tempPuzzle->moveCount << endl << endl;
-            outputFile << "\t\tTotal Moves: " << tempPuzzle->moveCount << endl << endl;
-            
-            //Printing the final puzzle
-            puzzlePrinter(tempPuzzle->currentState, outputFile);
-            
-            //Asking the user if they want to see each move that was taken
-            char decision = NULL;
-            cout << "\tWould you like to see all the moves used?\n";
-            cout << "\tEnter Y for Yes or N for No.\n";
-            cout << "\tDecision:";
-            cin >> decision;
-            cout << endl << endl;
-            
-            //Verifies input is Y or N. IF NOT, requests new input
-            while(decision != 'Y' && decision != 'y' && decision != 'N' && decision != 'n' )
-            {
-                cout << "\nPlease enter a correct selection.\n";
-                cout << "Enter Here:  ";
-                cin >> decision;
-            }
-            
-            //If the user enters "y" or "Y" then call the printPath function
-            if(decision == 'y' || decision == 'Y')
-            {
-                outputFile << "Printing each move from start to finish.\n\n";
-                distancePrintPath(tempPuzzle, tempPuzzle->moveCount, outputFile);
-                cout << endl << endl;
-            }
-            
-            //Clearing the list
-            puzzleList.clear();
-            
-            //Asking the user if they want to use the same array for a different search, if they do not
-            //this function will send them back to the main menu.
-            useSameArray(startingPuzzle, outputFile);
-        }
-        
-        //-----------ELSE--------------
-        
-        //Checking if the space can move up, if yes, swaps locations, increments the counter,
-        //and pop the new puzzle onto the stack
-        if (moveUp(tempPuzzle->spaceLocation) && !listSearch(arrayToIntConverter(tempPuzzle->currentState)))
-        {
-            //Creating the new state
-            State* child = newState(tempPuzzle->currentState, tempPuzzle->spaceLocation, tempPuzzle->moveCount + 1, tempPuzzle->spaceLocation - 3, tempPuzzle);
-            
-            //Calculate the manhatten distance for the child node
-            child->manhattanDistance = getManhattanDistance(child->currentState, outputFile) + child->moveCount;
-            
-            //Pushing the tempPuzzle onto the stack
-            mdQueue.push(child);
-        }
-        
-        //Checking if the space can move right, if yes, swaps locations, increments the counter,
-        //and pop the new puzzle onto the stack
-        if (moveRight(tempPuzzle->spaceLocation) && !listSearch(arrayToIntConverter(tempPuzzle->currentState)))
-        {
-            //Creating the new state
-            State* child = newState(tempPuzzle->currentState, tempPuzzle->spaceLocation, tempPuzzle->moveCount + 1, tempPuzzle->spaceLocation + 1, tempPuzzle);
-            
-            //Calculate the manhatten distance for the child node
-            child->manhattanDistance = getManhattanDistance(child->currentState, outputFile) + child->moveCount;
-            
-            //Pushing the tempPuzzle onto the stack
-            mdQueue.push(child);
-        }
-        
-        //Checking if the space can move down, if yes, swaps locations, increments the counter,
-        //and pop the new puzzle onto the stack
-        if (moveDown(tempPuzzle->spaceLocation) && !listSearch(arrayToIntConverter(tempPuzzle->currentState)))
-        {
-            //Creating the new state
-            State* child = newState(tempPuzzle->currentState, tempPuzzle->spaceLocation, tempPuzzle->moveCount + 1, tempPuzzle->spaceLocation + 3, tempPuzzle);
-            
-            //Calculate the manhatten distance for the child node
-            child->manhattanDistance = getManhattanDistance(child->currentState, outputFile) + child->moveCount;
-            
-            //Pushing the tempPuzzle onto the stack
-            mdQueue.push(child);
-        }
+        auto interval = chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(progressInterval));
+        auto start = chrono::steady_clock::now();
+        auto lastReport = start;
+        long lastNodes = 0;
         
-        //Checking if the space can move left, if yes, swaps locations, increments the counter,
-        //and pop the new puzzle onto the stack
-        if (moveLeft(tempPuzzle->spaceLocation) && !listSearch(arrayToIntConverter(tempPuzzle->currentState)))
+        //Printing once each interval until the search finishes
+        unique_lock<mutex> lock(reporterMutex);
+        while(!searchFinished.wait_for(lock, interval, [&] { return finished; }))
         {
-            //Creating the new state
-            State* child = newState(tempPuzzle->currentState, tempPuzzle->spaceLocation, tempPuzzle->moveCount + 1, tempPuzzle->spaceLocation - 1, tempPuzzle);
+            auto now = chrono::steady_clock::now();
+            long nodes = progress.nodes.load(memory_order_relaxed);
+            double seconds = chrono::duration<double>(now - lastReport).count();
             
-            //Calculate the manhatten distance for the child node
-            child->manhattanDistance = getManhattanDistance(child->currentState, outputFile) + child->moveCount;
+            printProgress(progress, chrono::duration<double>(now - start).count(), (nodes - lastNodes) / seconds, outputFile);
             
-            //Pushing the tempPuzzle onto the stack
-            mdQueue.push(child);
+            lastReport = now;
+            lastNodes = nodes;
         }
-        
-        //Adding the tempPuzzle to the List
-        puzzleList.push_front(arrayToIntConverter(tempPuzzle->currentState));
-    }
-    //NO SOLUTION FOUND
-    cout << "\nNo Solution Found." << endl;
-    
-    //Stopping timer
-    auto end = chrono::system_clock::now();
-    
-    //Getting the total elapsed time: End time - Start time = Total time elapsed.
-    chrono::duration<double> elapsedTime = (end - start);
+    });
     
-    //Notifying user of the time it took to complete the sorting.
-    cout << "\nManhattan Distance Search Elapsed time: " << elapsedTime.count() << "s\n\n";
-    outputFile << "\nManhattan Distance Search Elapsed time: " << elapsedTime.count() << "s\n\n";
-    
-    //Printing the total nodes count.
-    cout << "\t\tTotal Nodes Created: " << totalNodeCount << endl << endl;
-    outputFile << "\t\tTotal Nodes Created: " << totalNodeCount << endl << endl;
+    SolveResult result = solve(makeBoard(puzzleArray), algorithm, limits);
     
-    //Clearing the list
-    puzzleList.clear();
+    //Stopping the reporter
+    {
+        lock_guard<mutex> lock(reporterMutex);
+        finished = true;
+    }
+    searchFinished.notify_one();
+    reporter.join();
     
-    //Asking the user if they want to use the same array for a different search, if they do not
-    //this function will send them back to the main menu.
-    useSameArray(startingPuzzle, outputFile);
+    return result;
 }
 
 //---------------------------------------------------------------------------------------
-//puzzlePrinter - Prints a puzzle to the user and the output file
+//printProgress - Prints one progress line for a running search
 //---------------------------------------------------------------------------------------
-void puzzlePrinter(int puzzleArray[], fstream& outputFile)
+void printProgress(const SearchProgress& progress, double elapsedTime, double nodesPerSecond, fstream& outputFile)
 {
-    cout << "\t\t_\t_\t_\t_\t_\t_\t_\n";
-    cout << "\t\t|\t" << puzzleArray[0] << "\t|\t" << puzzleArray[1] << "\t|\t" << puzzleArray[2] << "\t|\n";
-    cout << "\t\t|\t-\t-\t-\t-\t-\t|\n";
-    cout << "\t\t|\t" << puzzleArray[3] << "\t|\t" << puzzleArray[4] << "\t|\t" << puzzleArray[5] << "\t|\n";
-    cout << "\t\t|\t-\t-\t-\t-\t-\t|\n";
-    cout << "\t\t|\t" << puzzleArray[6] << "\t|\t" << puzzleArray[7] << "\t|\t" << puzzleArray[8] << "\t|\n";
-    cout << "\t\t-\t-\t-\t-\t-\t-\t-\n\n";
+    int bound = progress.bound.load(memory_order_relaxed);
+    
+    ostringstream line;
+    line << fixed << setprecision(1) << "\t[" << elapsedTime << "s] "
+         << progress.nodes.load(memory_order_relaxed) << " nodes, "
+         << setprecision(0) << nodesPerSecond << " nodes/sec, depth "
+         << progress.depth.load(memory_order_relaxed);
+    if(bound >= 0)
+    {
+        line << ", f " << bound;
+    }
+    line << ", open list " << progress.openSize.load(memory_order_relaxed)
+         << setprecision(1) << ", memory " << progress.memoryBytes.load(memory_order_relaxed) / 1048576.0 << " MB\n";
     
-    outputFile << "\t\t_\t_\t_\t_\t_\t_\t_\n";
-    outputFile << "\t\t|\t" << puzzleArray[0] << "\t|\t" << puzzleArray[1] << "\t|\t" << puzzleArray[2] << "\t|\n";
-    outputFile << "\t\t|\t-\t-\t-\t-\t-\t|\n";
-    outputFile << "\t\t|\t" << puzzleArray[3] << "\t|\t" << puzzleArray[4] << "\t|\t" << puzzleArray[5] << "\t|\n";
-    outputFile << "\t\t|\t-\t-\t-\t-\t-\t|\n";
-    outputFile << "\t\t|\t" << puzzleArray[6] << "\t|\t" << puzzleArray[7] << "\t|\t" << puzzleArray[8] << "\t|\n";
-    outputFile << "\t\t-\t-\t-\t-\t-\t-\t-\n\n";
+    cout << line.str() << flush;
+    outputFile << line.str();
 }
 
 //---------------------------------------------------------------------------------------
-//puzzleSolved - This bool checks to see if a puzzle is solved.
+//puzzlePrinter - Prints a puzzle to the user and the output file
 //---------------------------------------------------------------------------------------
-bool puzzleSolved(int puzzleArray)
+void puzzlePrinter(const int puzzleArray[], fstream& outputFile)
 {
-    int goalArray = 123456780;
+    //Building the grid once so the user and the output file see the same thing
+    stringstream grid;
     
-    //if the two arrays are equal, return true
-    if (puzzleArray == goalArray)
+    grid << "\t\t_";
+    for(int i = 0; i < 2 * PUZZLE_WIDTH; i++)
     {
-        return true;
+        grid << "\t_";
     }
+    grid << "\n";
     
-    return false;
-}
-
-//---------------------------------------------------------------------------------------
-//findEmptySpace - Finds the empty space of the puzzle and returns its location
-//---------------------------------------------------------------------------------------
-int findEmptySpace(int puzzleArray[])
-{
-    //Variable to hold the spot of the empty location
-    int emptyLocation = 0;
-    
-    //For loop to check each spot of the array for the empty location '0'
-    //When it finds the location that == 0, sets it to our variable and then returns the location
-    for(int x = 0; x < PUZZLE_LENGTH; x++)
+    for(int row = 0; row < PUZZLE_HEIGHT; row++)
     {
-        if(puzzleArray[x] == 0)
+        //Line between two rows
+        if(row > 0)
+        {
+            grid << "\t\t|";
+            for(int i = 0; i < 2 * PUZZLE_WIDTH - 1; i++)
+            {
+                grid << "\t-";
+            }
+            grid << "\t|\n";
+        }
+        
+        grid << "\t\t|";
+        for(int column = 0; column < PUZZLE_WIDTH; column++)
         {
-            emptyLocation = x;
+            grid << "\t" << puzzleArray[row * PUZZLE_WIDTH + column] << "\t|";
         }
+        grid << "\n";
+    }
+    
+    grid << "\t\t-";
+    for(int i = 0; i < 2 * PUZZLE_WIDTH; i++)
+    {
+        grid << "\t-";
     }
+    grid << "\n\n";
     
-    return emptyLocation;
+    cout << grid.str();
+    outputFile << grid.str();
 }
 
 //------------------------------------------------------------------------------------------------
@@ -1652,454 +1429,1912 @@ void pressToContinue(fstream& outputFile)
     //Forwarding to main menu
     puzzleMainMenu(outputFile);
 }
-//------------------------------------------------------------------------------------------------
-//moveUp - If space is not in location 0, 1, or 2; It can move up (returns true) else returns false.
-//------------------------------------------------------------------------------------------------
-bool moveUp(int spaceLocation)
-{
-    return spaceLocation > 2;
-}
 
-//------------------------------------------------------------------------------------------------
-//moveRight - If space is not in location 2, 5, or 8; It can move right (returns true) else returns false.
-//------------------------------------------------------------------------------------------------
-bool moveRight(int spaceLocation)
-{
-    return (spaceLocation != 2 && spaceLocation != 5 && spaceLocation != 8);
-}
-
-//------------------------------------------------------------------------------------------------
-//moveDown - If space is not in location 6, 7, or 8; It can move up (returns true) else returns false.
-//------------------------------------------------------------------------------------------------
-bool moveDown(int spaceLocation)
-{
-    return spaceLocation < 6;
-}
-
-//------------------------------------------------------------------------------------------------
-//moveLeft - If space is not in location 0, 3, or 6; It can move left (returns true) else returns false.
-//------------------------------------------------------------------------------------------------
-bool moveLeft(int spaceLocation)
+//----------------------------------------------------------------------
+//printPath - Will print each move taken step by step from the starting state to the solve state
+//----------------------------------------------------------------------
+void printPath(const vector<State>& path, fstream& outputFile)
 {
-    return (spaceLocation != 0 && spaceLocation != 3 && spaceLocation != 6);
+    for(size_t step = 0; step < path.size(); step++)
+    {
+        //Printing the move with the number of which move it is.
+        if (step == 0)
+        {
+            cout << "\tStarting State:\n";
+            outputFile << "\tStarting State:\n";
+        }
+        else
+        {
+            cout << "\tStep Number: " << step << endl;
+            outputFile << "\tStep Number: " << step << endl;
+        }
+        
+        //Printing the current state
+        puzzlePrinter(path[step].currentState, outputFile);
+    }
 }
 
-//------------------------------------------------------------------------------------------------
-//listSearch - Checks the linked list to see if the puzzle has been seen before
-//------------------------------------------------------------------------------------------------
-bool listSearch(int puzzleArray)
+//----------------------------------------------------------------------
+//tilesPrintPath - Will print each move taken step by step for misplacedTiles until reaching the solve state
+//----------------------------------------------------------------------
+void tilesPrintPath(const vector<State>& path, fstream& outputFile)
 {
-    //Iterating through the list to check if the two arrays are the same.
-    for(int a = 0; a < puzzleList.size(); a++)
+    for(size_t step = 0; step < path.size(); step++)
     {
-        list<int> :: iterator it = puzzleList.begin();
-        
-        advance(it, a);
-        
-        //if the two arrays are equal, return true
-        if (puzzleArray == *it)
+        //Printing the move with the number of which move it is.
+        if (step == 0)
         {
-            return true;
+            cout << "\tStarting State:\n";
+            outputFile << "\tStarting State:\n";
+        }
+        else
+        {
+            cout << "\tStep Number: " << step << endl;
+            outputFile << "\tStep Number: " << step << endl;
         }
+        cout << "\tNumber of Misplace Tiles:" << path[step].misplacedTiles << endl;
+        outputFile << "\tNumber of Misplace Tiles:" << path[step].misplacedTiles << endl;
+        
+        //Printing the current state
+        puzzlePrinter(path[step].currentState, outputFile);
     }
-    
-    //If puzzle is not in the linked list, return false
-    return false;
 }
 
 //----------------------------------------------------------------------
-//countMisplacedTiles - This functon returns the number of misplaced tiles from the current state
+//distancePrintPath - Will print each move taken step by step for manhattanDistance until reaching the solve state
 //----------------------------------------------------------------------
-int countMisplacedTiles(int puzzleArray[], fstream& outputFile)
+void distancePrintPath(const vector<State>& path, fstream& outputFile)
 {
-    //Variable to holds the number of misplaced tiles
-    int numberMisplacedTiles = 0;
-    
-    //Checks each allocation of the array to determine how many tiles are out of place.
-    for(int i = 0; i < PUZZLE_LENGTH; i++)
+    for(size_t step = 0; step < path.size(); step++)
     {
-        //If the current state tile being check is not equal to the solved puzzle tile
-        //incrememnt the count
-        if(puzzleArray[i] != solvedPuzzle[i])
+        //Printing the move with the number of which move it is.
+        if (step == 0)
+        {
+            cout << "\tStarting State:\n";
+            outputFile << "\tStarting State:\n";
+        }
+        else
         {
-            numberMisplacedTiles++;
+            cout << "\tStep Number: " << step << endl;
+            outputFile << "\tStep Number: " << step << endl;
         }
+        cout << "\tManhattan Distance:" << path[step].manhattanDistance << endl;
+        outputFile << "\tManhattan Distance:" << path[step].manhattanDistance << endl;
+        
+        //Printing the current state
+        puzzlePrinter(path[step].currentState, outputFile);
     }
-    
-    //Return the number of misplaced tiles.
-    return numberMisplacedTiles;
 }
 
 //----------------------------------------------------------------------
-//printPath - Will print each move taken step by step for misplacedTiles using recursion until reaching the solve state
+//useSameArray - This function asks the user if they would like to use the same starting array for a new search algorithm
 //----------------------------------------------------------------------
-void printPath(State* root, int moveCount, fstream& outputFile)
+void useSameArray(int puzzleArray[], fstream& outputFile)
 {
+    char useAgain = 0;
+    
+    cout << "Would you like to use the same starting puzzle\n";
+    cout << "in a different search?\n";
+    cout << "Please enter 'Y' for YES or 'N' for NO.\n";
+    cout << "Enter Here: ";
+    cin >> useAgain;
     
-    //If reached the final state in the list, return
-    if (root == NULL)
+    //Verifies input is Y or N. IF NOT, requests new input
+    while(useAgain != 'Y' && useAgain != 'y' && useAgain != 'N' && useAgain != 'n' )
     {
-        return;
+        cout << "\nPlease enter a correct selection.\n";
+        cout << "Enter Here:  ";
+        cin >> useAgain;
     }
     
-    //Recursive call the the path printer
-    moveCount--;
-    printPath(root->parent, moveCount, outputFile);
-    
-    //Printing the move with the number of which move it is.
-    if (moveCount == -1)
+    //If the user input Y for yes, call the solvint options menu.
+    if (useAgain == 'y' || useAgain == 'Y')
     {
-        cout << "\tStarting State:\n";
-        outputFile << "\tStarting State:\n";
+        cout << endl << endl;
+        howToSolveMenu(puzzleArray, outputFile);
     }
-    else
+    else //Else send to main menu
     {
-        cout << "\tStep Number: " << moveCount + 1<< endl;
-        outputFile << "\tStep Number: " << moveCount + 1<< endl;
+        cout << endl << endl;
+        pressToContinue(outputFile);
     }
-    
-    //Printing the current state
-    puzzlePrinter(root->currentState, outputFile);
 }
 
-
 //----------------------------------------------------------------------
-//printPath - Will print each move taken step by step for misplacedTiles using recursion until reaching the solve state
+//puzzleInvalidMenu - This menu is called if the input puzzle cannot be solved
 //----------------------------------------------------------------------
-void tilesPrintPath(State* root, int moveCount, fstream& outputFile)
+void puzzleInvalidMenu(fstream& outputFile, int puzzleArray[])
 {
+    int userSelection = 0;
     
-    //If reached the final state in the list, return
-    if (root == NULL)
-    {
-        return;
-    }
+    cout << "Please make a selection:" << endl;
+    cout << "\t1: Attempt puzzle." << endl;
+    cout << "\t2: Input a new puzzle." << endl;
+    cout << "\t3: Exit to main menu." << endl << endl;
     
-    //Recursive call the the path printer
-    moveCount--;
-    tilesPrintPath(root->parent, moveCount, outputFile);
+    cin >> userSelection;
     
-    //Printing the move with the number of which move it is.
-    if (moveCount == -1)
-    {
-        cout << "\tStarting State:\n";
-        outputFile << "\tStarting State:\n";
-        cout << "\tNumber of Misplace Tiles:" << root->misplacedTiles << endl;
-        outputFile << "\tNumber of Misplace Tiles:" << root->misplacedTiles << endl;
-    }
-    else
+    //Verifies input is an integer. IF NOT, requests new input
+    while(!integerVerify(userSelection))
     {
-        cout << "\tStep Number: " << moveCount + 1<< endl;
-        outputFile << "\tStep Number: " << moveCount + 1<< endl;
-        cout << "\tNumber of Misplace Tiles:" << root->misplacedTiles << endl;
-        outputFile << "\tNumber of Misplace Tiles:" << root->misplacedTiles << endl;
+        cout << "Please Enter a Selection: ";
+        cin >> userSelection;
     }
     
-    //Printing the current state
-    puzzlePrinter(root->currentState, outputFile);
+    //Spacer Line
+    cout << endl;
+    
+    //calling the switch
+    puzzleInvalidMenuSwitch(userSelection, puzzleArray, outputFile);
 }
 
 //----------------------------------------------------------------------
-//distancePrintPath - Will print each move taken step by step for manhattanDistance using recursion until reaching the solve state
+//puzzleInvalidMenuSwitch - This is the switch for the invalid menu
 //----------------------------------------------------------------------
-void distancePrintPath(State* root, int moveCount, fstream& outputFile)
+void puzzleInvalidMenuSwitch(int userSelection, int puzzleArray[], fstream& outputFile)
 {
-    
-    //If reached the final state in the list, return
-    if (root == NULL)
+    //Setting up the switch for the user selection
+    switch (userSelection)
     {
-        return;
-    }
-    
-    //Recursive call the the path printer
-    moveCount--;
-    distancePrintPath(root->parent, moveCount, outputFile);
+        case 1://Breadth First Search
+        {
+            howToSolveMenu(puzzleArray, outputFile);
+            break;
+        }
+        case 2://Depth First Search
+        {
+            puzzleEntry(outputFile);
+            break;
+        }
+        case 3://A* using the number of misplaced tiles.
+        {
+            puzzleMainMenu(outputFile);
+            break;
+        }
+        default://Invalid selection
+        {
+            cout << "\t::Invalid Selection::\n";
+            puzzleInvalidMenu(outputFile, puzzleArray);
+            break;
+        }
+    }
+}
+
+//----------------------------------------------------------------------
+//benchmarkCorpus - Returns the fixed set of puzzles for a named corpus. Every corpus is
+//                  built from a fixed seed so each run sees the same puzzles.
+//----------------------------------------------------------------------
+vector<vector<int>> benchmarkCorpus(const string& corpusName)
+{
+    vector<vector<int>> corpus;
+    
+    if(corpusName == "solved")          //The goal itself, which every search must solve in no moves
+    {
+        corpus.push_back(vector<int>(solvedPuzzle, solvedPuzzle + PUZZLE_LENGTH));
+    }
+    else if(corpusName == "shallow")    //20 puzzles scrambled by 8 moves
+    {
+        uint64_t seed = 413008;
+        for(int i = 0; i < 20; i++)
+        {
+            vector<int> puzzle(PUZZLE_LENGTH);
+            randomWalkPuzzle(puzzle.data(), 8, seed);
+            corpus.push_back(puzzle);
+        }
+    }
+    else if(corpusName == "medium")     //20 puzzles scrambled by 20 moves
+    {
+        uint64_t seed = 413020;
+        for(int i = 0; i < 20; i++)
+        {
+            vector<int> puzzle(PUZZLE_LENGTH);
+            randomWalkPuzzle(puzzle.data(), 20, seed);
+            corpus.push_back(puzzle);
+        }
+    }
+#if PUZZLE_WIDTH == 3 && PUZZLE_HEIGHT == 3
+    else if(corpusName == "depth31")    //The only two puzzles that need 31 moves
+    {
+        corpus.push_back({8,6,7,2,5,4,3,0,1});
+        corpus.push_back({6,4,7,8,5,0,3,2,1});
+    }
+#endif
+    
+    return corpus;
+}
+
+//----------------------------------------------------------------------
+//benchmarkCorpusNames - Returns the names of the corpora this build has, the ones --corpus all
+//                       runs. Some corpora only exist for one board shape.
+//----------------------------------------------------------------------
+vector<string> benchmarkCorpusNames()
+{
+    vector<string> corpusNames = {"solved", "shallow", "medium"};
+    
+#if PUZZLE_WIDTH == 3 && PUZZLE_HEIGHT == 3
+    corpusNames.push_back("depth31");
+#endif
+    
+    return corpusNames;
+}
+
+//----------------------------------------------------------------------
+//peakMemoryUsage - Returns the peak resident memory of the program in bytes
+//----------------------------------------------------------------------
+size_t peakMemoryUsage()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    
+#ifdef __APPLE__
+    return (size_t) usage.ru_maxrss;            //Reported in bytes on macOS
+#else
+    return (size_t) usage.ru_maxrss * 1024;     //Reported in kilobytes on Linux
+#endif
+}
+
+//----------------------------------------------------------------------
+//runBenchmark - Runs the selected searches over the selected corpora and prints the results.
+//               Usage: --benchmark [--solver NAME,...|all] [--corpus NAME|all] [--trials N]
+//                                  [--baseline FILE] [--save-baseline FILE] [--tolerance T]
+//               Returns 1 if any result is worse than the baseline, otherwise 0.
+//----------------------------------------------------------------------
+int runBenchmark(int argc, const char* argv[])
+{
+    //Default settings. Depth first search is left out by default since it wanders most of
+    //the state space before it finds the goal.
+    string solverName = "bfs,misplaced,manhattan";
+    string corpusName = "shallow";
+    string baselineFile = "";
+    string saveBaselineFile = "";
+    int trials = 3;
+    double tolerance = 0.10;
+    
+    //Reading the command line options
+    for(int i = 2; i < argc; i++)
+    {
+        string option = argv[i];
+        
+        if(i + 1 >= argc)
+        {
+            cout << "Missing value for " << option << endl;
+            return 2;
+        }
+        
+        if(option == "--solver")
+        {
+            solverName = argv[++i];
+        }
+        else if(option == "--corpus")
+        {
+            corpusName = argv[++i];
+        }
+        else if(option == "--trials")
+        {
+            trials = max(1, atoi(argv[++i]));
+        }
+        else if(option == "--baseline")
+        {
+            baselineFile = argv[++i];
+        }
+        else if(option == "--save-baseline")
+        {
+            saveBaselineFile = argv[++i];
+        }
+        else if(option == "--tolerance")
+        {
+            tolerance = atof(argv[++i]);
+        }
+        else
+        {
+            cout << "Unknown option " << option << endl;
+            return 2;
+        }
+    }
+    
+    //Building the list of corpora to run
+    vector<string> corpusNames;
+    if(corpusName == "all")
+    {
+        corpusNames = benchmarkCorpusNames();
+    }
+    else
+    {
+        corpusNames.push_back(corpusName);
+    }
+    
+    //Holds the results of each solver over each corpus
+    vector<BenchmarkRow> rows;
+    
+    cout << left << setw(12) << "solver" << setw(10) << "corpus" << right
+         << setw(14) << "sec/solve" << setw(14) << "nodes/sec" << setw(10) << "length"
+         << setw(14) << "bytes/solve" << setw(10) << "unsolved" << setw(12) << "h-cache hit" << endl;
+    
+    //Holds the seen list the solvers reuse from one puzzle to the next
+    SearchContext context;
+    
+    for(size_t c = 0; c < corpusNames.size(); c++)
+    {
+        vector<vector<int>> corpus = benchmarkCorpus(corpusNames[c]);
+        
+        if(corpus.empty())
+        {
+            cout << "Unknown corpus " << corpusNames[c] << endl;
+            return 2;
+        }
+        
+        for(const SolverEntry& solver : solverTable)
+        {
+            //Skipping the solvers that were not selected
+            if(solverName != "all" && ("," + solverName + ",").find("," + string(solver.name) + ",") == string::npos)
+            {
+                continue;
+            }
+            
+            double totalTime = 0.0;
+            double totalNodes = 0.0;
+            double totalLength = 0.0;
+            double totalMemory = 0.0;
+            int solved = 0;
+            
+            //Counting the heuristic cache lookups for this solver alone
+            context.manhattanCache.hits = context.manhattanCache.misses = 0;
+            context.misplacedCache.hits = context.misplacedCache.misses = 0;
+            
+            for(size_t p = 0; p < corpus.size(); p++)
+            {
+                //Running every trial and keeping the median time
+                vector<double> trialTimes;
+                
+                for(int t = 0; t < trials; t++)
+                {
+                    //Emptying the heuristic caches so no trial starts with the values of the last
+                    context.manhattanCache.clear();
+                    context.misplacedCache.clear();
+                    
+                    SearchResult result = solver.run(corpus[p].data(), Limits(), context);
+                    trialTimes.push_back(result.elapsedTime);
+                    
+                    //The node count, length and memory are the same for every trial
+                    if(t == 0)
+                    {
+                        totalNodes += result.totalNodeCount;
+                        totalMemory += result.memoryBytes;
+                        
+                        if(result.goalState != NULL)
+                        {
+                            totalLength += result.goalState->moveCount;
+                            solved++;
+                        }
+                    }
+                    
+                    releaseSearchResult(result);
+                }
+                
+                sort(trialTimes.begin(), trialTimes.end());
+                totalTime += trialTimes[trialTimes.size() / 2];
+            }
+            
+            BenchmarkRow row;
+            row.solver = solver.name;
+            row.corpus = corpusNames[c];
+            row.timePerSolve = totalTime / corpus.size();
+            row.nodesPerSecond = totalTime > 0.0 ? totalNodes / totalTime : 0.0;
+            row.averageLength = solved > 0 ? totalLength / solved : 0.0;
+            row.averageMemory = totalMemory / corpus.size();
+            row.unsolved = (int) corpus.size() - solved;
+            rows.push_back(row);
+            
+            cout << left << setw(12) << row.solver << setw(10) << row.corpus << right
+                 << setw(14) << row.timePerSolve << setw(14) << (long long) row.nodesPerSecond
+                 << setw(10) << row.averageLength << setw(14) << (long long) row.averageMemory
+                 << setw(10) << row.unsolved;
+            
+            //Showing how often a board's heuristic was already known, for the searches that use one
+            uint64_t hits = context.manhattanCache.hits + context.misplacedCache.hits;
+            uint64_t lookups = hits + context.manhattanCache.misses + context.misplacedCache.misses;
+            if(lookups > 0)
+            {
+                cout << setw(11) << fixed << setprecision(1) << 100.0 * hits / lookups << "%" << defaultfloat << setprecision(6) << endl;
+            }
+            else
+            {
+                cout << setw(12) << "-" << endl;
+            }
+        }
+    }
+    
+    cout << "\nPeak memory: " << peakMemoryUsage() << " bytes\n";
+    
+    //Saving the results as the new baseline
+    if(!saveBaselineFile.empty() && !saveBenchmarkBaseline(saveBaselineFile, rows))
+    {
+        cout << "Could not write baseline " << saveBaselineFile << endl;
+        return 2;
+    }
+    
+    //Comparing the results against a saved baseline
+    int regressions = 0;
+    if(!baselineFile.empty())
+    {
+        vector<BenchmarkRow> baseline;
+        if(!loadBenchmarkBaseline(baselineFile, baseline))
+        {
+            cout << "Could not read baseline " << baselineFile << endl;
+            return 2;
+        }
+        
+        for(const BenchmarkRow& row : rows)
+        {
+            for(const BenchmarkRow& base : baseline)
+            {
+                if(row.solver != base.solver || row.corpus != base.corpus)
+                {
+                    continue;
+                }
+                
+                if(row.timePerSolve > base.timePerSolve * (1.0 + tolerance))
+                {
+                    cout << "REGRESSION " << row.solver << " " << row.corpus << ": " << row.timePerSolve
+                         << " sec/solve against " << base.timePerSolve << endl;
+                    regressions++;
+                }
+                if(row.averageLength > base.averageLength || row.unsolved > base.unsolved)
+                {
+                    cout << "REGRESSION " << row.solver << " " << row.corpus << ": length " << row.averageLength
+                         << " unsolved " << row.unsolved << " against length " << base.averageLength
+                         << " unsolved " << base.unsolved << endl;
+                    regressions++;
+                }
+            }
+        }
+        
+        cout << regressions << " regression(s) against " << baselineFile << endl;
+    }
+    
+    return regressions > 0 ? 1 : 0;
+}
+
+//----------------------------------------------------------------------
+//loadBenchmarkBaseline - Reads a baseline written by saveBenchmarkBaseline
+//----------------------------------------------------------------------
+bool loadBenchmarkBaseline(const string& fileName, vector<BenchmarkRow>& rows)
+{
+    fstream baselineFile;
+    baselineFile.open(fileName, fstream::in);
+    
+    if(!baselineFile.is_open())
+    {
+        return false;
+    }
+    
+    string line;
+    while(getline(baselineFile, line))
+    {
+        //Skipping the comment lines
+        if(line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+        
+        BenchmarkRow row;
+        stringstream lineStream(line);
+        if(lineStream >> row.solver >> row.corpus >> row.timePerSolve >> row.nodesPerSecond
+                      >> row.averageLength >> row.averageMemory >> row.unsolved)
+        {
+            rows.push_back(row);
+        }
+    }
+    
+    return true;
+}
+
+//----------------------------------------------------------------------
+//saveBenchmarkBaseline - Writes the benchmark results to a file, one row per line
+//----------------------------------------------------------------------
+bool saveBenchmarkBaseline(const string& fileName, const vector<BenchmarkRow>& rows)
+{
+    fstream baselineFile;
+    baselineFile.open(fileName, fstream::out);
+    
+    if(!baselineFile.is_open())
+    {
+        return false;
+    }
+    
+    baselineFile << "# solver corpus secPerSolve nodesPerSec length bytesPerSolve unsolved\n";
+    for(const BenchmarkRow& row : rows)
+    {
+        baselineFile << row.solver << " " << row.corpus << " " << row.timePerSolve << " " << row.nodesPerSecond
+                     << " " << row.averageLength << " " << row.averageMemory << " " << row.unsolved << "\n";
+    }
+    
+    return true;
+}
+
+//Holds the results of the micro benchmark kernels so the compiler cannot remove them
+volatile long microBenchmarkSink = 0;
+
+//----------------------------------------------------------------------
+//microBenchmark - Times a kernel, doubling the number of calls until the run lasts at least
+//                 minimumTime seconds, then prints nanoseconds and allocations per call.
+//----------------------------------------------------------------------
+template <typename Kernel>
+void microBenchmark(const string& kernelName, double minimumTime, Kernel kernel)
+{
+    long iterations = 1;
+    double elapsed = 0.0;
+    size_t allocations = 0;
+    
+    while(true)
+    {
+        size_t allocationsBefore = allocationCount;
+        auto start = chrono::steady_clock::now();
+        
+        for(long i = 0; i < iterations; i++)
+        {
+            kernel(i);
+        }
+        
+        chrono::duration<double> elapsedTime = chrono::steady_clock::now() - start;
+        elapsed = elapsedTime.count();
+        allocations = allocationCount - allocationsBefore;
+        
+        if(elapsed >= minimumTime || iterations >= (1L << 40))
+        {
+            break;
+        }
+        
+        iterations *= 2;
+    }
+    
+    cout << left << setw(36) << kernelName << right << setw(14) << fixed << setprecision(2)
+         << elapsed * 1e9 / iterations << setw(14) << setprecision(3) << (double) allocations / iterations
+         << setw(16) << iterations << defaultfloat << endl;
+}
+
+//----------------------------------------------------------------------
+//concurrentInsertBenchmark - Times threadCount threads each adding every puzzle to a shared
+//                            seen set, and prints the time per insert like microBenchmark
+//----------------------------------------------------------------------
+template <typename Insert>
+void concurrentInsertBenchmark(const string& kernelName, unsigned threadCount, const vector<PackedPuzzle>& packedPuzzles, Insert insert)
+{
+    atomic<size_t> added(0);
+    atomic<size_t> allocations(0);
+    auto start = chrono::steady_clock::now();
+    
+    vector<thread> threads;
+    for(unsigned t = 0; t < threadCount; t++)
+    {
+        threads.emplace_back([&, t]
+        {
+            countingAllocations = true;
+            
+            size_t puzzleCount = packedPuzzles.size();
+            size_t offset = puzzleCount * t / threadCount;
+            size_t threadAdded = 0;
+            
+            for(size_t i = 0; i < puzzleCount; i++)
+            {
+                threadAdded += insert(packedPuzzles[(offset + i) % puzzleCount]);
+            }
+            added.fetch_add(threadAdded, memory_order_relaxed);
+            allocations.fetch_add(allocationCount, memory_order_relaxed);
+        });
+    }
+    for(thread& worker : threads)
+    {
+        worker.join();
+    }
+    
+    chrono::duration<double> elapsedTime = chrono::steady_clock::now() - start;
+    long iterations = (long) (packedPuzzles.size() * threadCount);
+    
+    //Every puzzle must have been added exactly once across the threads
+    if(added.load() != packedPuzzles.size())
+    {
+        cout << kernelName << ": added " << added.load() << " of " << packedPuzzles.size() << " puzzles" << endl;
+    }
+    
+    cout << left << setw(36) << kernelName << right << setw(14) << fixed << setprecision(2)
+         << elapsedTime.count() * 1e9 / iterations << setw(14) << setprecision(3) << (double) allocations.load() / iterations
+         << setw(16) << iterations << defaultfloat << endl;
+}
+
+//----------------------------------------------------------------------
+//runMicroBenchmark - Times the functions that make up the cost of each search node.
+//                    Usage: --microbench [--time SECONDS]
+//----------------------------------------------------------------------
+int runMicroBenchmark(int argc, const char* argv[])
+{
+    //Minimum time spent on each kernel
+    double minimumTime = 0.2;
+    
+    //Reading the command line options
+    for(int i = 2; i < argc; i++)
+    {
+        string option = argv[i];
+        
+        if(option == "--time" && i + 1 < argc)
+        {
+            minimumTime = atof(argv[++i]);
+        }
+        else
+        {
+            cout << "Unknown option " << option << endl;
+            return 2;
+        }
+    }
+    
+    //Counting the allocations each kernel makes on this thread
+    countingAllocations = true;
+    
+    //Using the medium corpus as the puzzles fed to each kernel
+    vector<vector<int>> corpus = benchmarkCorpus("medium");
+    size_t corpusSize = corpus.size();
+    
+    //Holds the goal and seen list the kernels use
+    SearchContext context;
+    
+    //States with spread out heuristic values for the priority queue kernels
+    const int queueSize = 64;
+    vector<State*> queueStates;
+    for(int i = 0; i < queueSize; i++)
+    {
+        vector<int>& puzzle = corpus[i % corpusSize];
+        State* state = newState(puzzle.data(), findEmptySpace(puzzle.data()), 0, findEmptySpace(puzzle.data()), NULL);
+        state->misplacedTiles = countMisplacedTiles(state->currentState, context) + i % 7;
+        state->manhattanDistance = getManhattanDistance(state->currentState, context) + i % 11;
+        queueStates.push_back(state);
+    }
+    
+    cout << left << setw(36) << "kernel" << right << setw(14) << "ns/op" << setw(14) << "allocs/op"
+         << setw(16) << "iterations" << endl;
+    
+    microBenchmark("arrayToIntConverter", minimumTime, [&](long i)
+    {
+        microBenchmarkSink += arrayToIntConverter(corpus[i % corpusSize].data());
+    });
+    
+    //Searching for puzzles that are not in the list is the worst case
+    const int listSizes[] = {100, 1000};
+    for(int listSize : listSizes)
+    {
+        context.reset();
+        for(int i = 0; i < listSize; i++)
+        {
+            context.seenPuzzles.insert(i);
+        }
+        
+        microBenchmark("listSearch (" + to_string(listSize) + " entries, miss)", minimumTime, [&](long i)
+        {
+            microBenchmarkSink += listSearch(arrayToIntConverter(corpus[i % corpusSize].data()), context);
+        });
+    }
+    context.reset();
+    
+    microBenchmark("newState + delete", minimumTime, [&](long i)
+    {
+        vector<int>& puzzle = corpus[i % corpusSize];
+        int space = findEmptySpace(puzzle.data());
+        State* state = newState(puzzle.data(), space, 1, moveUp(space) ? space - PUZZLE_WIDTH : space + PUZZLE_WIDTH, NULL);
+        microBenchmarkSink += state->spaceLocation;
+        delete state;
+    });
+    
+    microBenchmark("getManhattanDistance", minimumTime, [&](long i)
+    {
+        microBenchmarkSink += getManhattanDistance(corpus[i % corpusSize].data(), context);
+    });
+    
+    //Every board in the corpus fits in the cache, so after the first pass each call is a hit
+    microBenchmark("cachedManhattanDistance", minimumTime, [&](long i)
+    {
+        microBenchmarkSink += cachedManhattanDistance(corpus[i % corpusSize].data(), context);
+    });
+    
+    microBenchmark("getRowAndColumn", minimumTime, [&](long i)
+    {
+        int row = 0;
+        int column = 0;
+        getRowAndColumn(corpus[i % corpusSize].data(), (int) (i % PUZZLE_LENGTH), row, column);
+        microBenchmarkSink += row + column;
+    });
+    
+    microBenchmark("countMisplacedTiles", minimumTime, [&](long i)
+    {
+        microBenchmarkSink += countMisplacedTiles(corpus[i % corpusSize].data(), context);
+    });
+    
+    microBenchmark("isSolvable", minimumTime, [&](long i)
+    {
+        microBenchmarkSink += isSolvable(corpus[i % corpusSize].data());
+    });
+    
+    microBenchmark("getInvCount", minimumTime, [&](long i)
+    {
+        microBenchmarkSink += getInvCount(corpus[i % corpusSize].data());
+    });
+    
+    microBenchmark("permutationParity", minimumTime, [&](long i)
+    {
+        microBenchmarkSink += permutationParity(corpus[i % corpusSize].data());
+    });
+    
+    //The queues are reserved up front so the timing covers the heap work only
+    vector<State*> queueStorage;
+    queueStorage.reserve(queueSize);
+    priority_queue<State*, vector<State*>, comp> pQueue(comp(), queueStorage);
+    priority_queue<State*, vector<State*>, mdcomp> mdQueue(mdcomp(), queueStorage);
+    
+    microBenchmark("priority_queue<comp> push+pop", minimumTime, [&](long i)
+    {
+        pQueue.push(queueStates[i % queueSize]);
+        if(pQueue.size() == queueSize)
+        {
+            while(!pQueue.empty())
+            {
+                microBenchmarkSink += pQueue.top()->misplacedTiles;
+                pQueue.pop();
+            }
+        }
+    });
+    
+    microBenchmark("priority_queue<mdcomp> push+pop", minimumTime, [&](long i)
+    {
+        mdQueue.push(queueStates[i % queueSize]);
+        if(mdQueue.size() == queueSize)
+        {
+            while(!mdQueue.empty())
+            {
+                microBenchmarkSink += mdQueue.top()->manhattanDistance;
+                mdQueue.pop();
+            }
+        }
+    });
+    
+    //Releasing the queue states
+    for(State* state : queueStates)
+    {
+        delete state;
+    }
+    
+    //Every solvable puzzle, packed, for the seen set kernels. Each thread adds all of them
+    //starting at a different place, so the threads race for the same puzzles. Boards bigger
+    //than 3x3 use the first 181440 so the run takes as long as it does on the 8-puzzle.
+    vector<PackedPuzzle> packedPuzzles(min<uint64_t>(solvablePuzzleCount(), 181440));
+    for(size_t r = 0; r < packedPuzzles.size(); r++)
+    {
+        int puzzle[PUZZLE_LENGTH];
+        unrankSolvablePuzzle(r, puzzle);
+        packedPuzzles[r] = arrayToIntConverter(puzzle);
+    }
+    
+    unsigned maximumThreads = max(2u, thread::hardware_concurrency());
+    for(unsigned threadCount = 1; threadCount <= maximumThreads; threadCount *= 2)
+    {
+        ConcurrentSeenSet seenSet(packedPuzzles.size());
+        concurrentInsertBenchmark("ConcurrentSeenSet insert (" + to_string(threadCount) + " threads)", threadCount, packedPuzzles, [&](PackedPuzzle packedPuzzle)
+        {
+            return seenSet.insert(packedPuzzle);
+        });
+        
+        unordered_set<PackedPuzzle> lockedSet;
+        mutex lockedSetMutex;
+        concurrentInsertBenchmark("mutex + unordered_set (" + to_string(threadCount) + " threads)", threadCount, packedPuzzles, [&](PackedPuzzle packedPuzzle)
+        {
+            lock_guard<mutex> lock(lockedSetMutex);
+            return lockedSet.insert(packedPuzzle).second;
+        });
+    }
+    
+    return 0;
+}
+
+
+//----------------------------------------------------------------------
+//runPuzzleGenerator - Writes random solvable puzzles, one per line with no spaces. With --depth
+//                     every puzzle needs exactly that many moves to solve.
+//                     Usage: --generate COUNT [--seed SEED] [--output FILE] [--depth MOVES]
+//----------------------------------------------------------------------
+int runPuzzleGenerator(int argc, const char* argv[])
+{
+    if(argc < 3)
+    {
+        cout << "Usage: --generate COUNT [--seed SEED] [--output FILE] [--depth MOVES]\n";
+        return 2;
+    }
+    
+    uint64_t puzzleCount = strtoull(argv[2], NULL, 10);
+    uint64_t seed = puzzleGeneratorSeed;
+    string outputName = "";
+    int depth = -1;
+    
+    //Reading the command line options
+    for(int i = 3; i < argc; i++)
+    {
+        string option = argv[i];
+        
+        if(option == "--seed" && i + 1 < argc)
+        {
+            seed = strtoull(argv[++i], NULL, 10);
+        }
+        else if(option == "--output" && i + 1 < argc)
+        {
+            outputName = argv[++i];
+        }
+        else if(option == "--depth" && i + 1 < argc)
+        {
+            depth = atoi(argv[++i]);
+        }
+        else
+        {
+            cout << "Unknown option " << option << endl;
+            return 2;
+        }
+    }
+    
+    //Checking there are puzzles at the requested depth before writing anything. Boards too big
+    //for the depth table find out puzzle by puzzle.
+    if(depth >= 0)
+    {
+        buildDepthTable();
+        
+        if(!depthBuckets.empty() && depth >= (int) depthBuckets.size())
+        {
+            cout << "No puzzle needs " << depth << " moves, the most is " << depthBuckets.size() - 1 << endl;
+            return 2;
+        }
+    }
+    
+    //Writing to standard out unless a file was named
+    FILE* output = stdout;
+    if(!outputName.empty())
+    {
+        output = fopen(outputName.c_str(), "wb");
+        if(output == NULL)
+        {
+            cout << "Could not open " << outputName << endl;
+            return 2;
+        }
+    }
+    
+    auto start = chrono::steady_clock::now();
+    
+    //Filling a buffer with whole lines and writing it out in large blocks
+    const size_t lineLength = PUZZLE_LENGTH + 1;
+    const size_t linesPerBlock = 8192;
+    vector<char> block(lineLength * linesPerBlock);
+    int puzzleArray[PUZZLE_LENGTH];
+    
+    for(uint64_t written = 0; written < puzzleCount; )
+    {
+        size_t lines = (size_t) min<uint64_t>(linesPerBlock, puzzleCount - written);
+        char* line = block.data();
+        
+        for(size_t l = 0; l < lines; l++)
+        {
+            if(depth < 0)
+            {
+                randomSolvablePuzzle(puzzleArray, seed);
+            }
+            else if(!depthTargetedPuzzle(puzzleArray, depth, seed))
+            {
+                cout << "Could not find a puzzle that needs " << depth << " moves" << endl;
+                if(output != stdout)
+                {
+                    fclose(output);
+                }
+                return 2;
+            }
+            
+            for(int i = 0; i < PUZZLE_LENGTH; i++)
+            {
+                line[i] = "0123456789abcdefghij"[puzzleArray[i]];
+            }
+            line[PUZZLE_LENGTH] = '\n';
+            line += lineLength;
+        }
+        
+        fwrite(block.data(), lineLength, lines, output);
+        written += lines;
+    }
+    
+    if(output != stdout)
+    {
+        fclose(output);
+    }
+    
+    //Reporting the rate on standard error so it does not mix with the puzzles
+    chrono::duration<double> elapsedTime = chrono::steady_clock::now() - start;
+    cerr << "Generated " << puzzleCount << " puzzles in " << elapsedTime.count() << "s ("
+         << (long long) (puzzleCount / max(elapsedTime.count(), 1e-9)) << " puzzles/sec)\n";
+    
+    return 0;
+}
+
+//----------------------------------------------------------------------
+//RankReader::open - Opens a rank file for reading. Returns false if it cannot be opened.
+//----------------------------------------------------------------------
+bool RankReader::open(const string& fileName)
+{
+    file = fopen(fileName.c_str(), "rb");
+    block.clear();
+    position = 0;
+    return file != NULL;
+}
+
+//----------------------------------------------------------------------
+//RankReader::next - Hands out the next rank in the file. Returns false at the end.
+//----------------------------------------------------------------------
+bool RankReader::next(uint64_t& rank)
+{
+    if(position == block.size())
+    {
+        //Reading the next block
+        block.resize(RANK_BLOCK_SIZE);
+        block.resize(fread(block.data(), sizeof(uint64_t), RANK_BLOCK_SIZE, file));
+        position = 0;
+        
+        if(block.empty())
+        {
+            return false;
+        }
+    }
+    
+    rank = block[position++];
+    return true;
+}
+
+//----------------------------------------------------------------------
+//RankReader::close - Closes the file. Returns false if a read failed, as next cannot tell that
+//                    apart from the end of the file.
+//----------------------------------------------------------------------
+bool RankReader::close()
+{
+    if(file == NULL)
+    {
+        return true;
+    }
+    
+    bool failed = ferror(file) != 0;
+    fclose(file);
+    file = NULL;
+    return !failed;
+}
+
+//----------------------------------------------------------------------
+//RankWriter::open - Creates a rank file, emptying any file of that name. Returns false if it
+//                   cannot be created.
+//----------------------------------------------------------------------
+bool RankWriter::open(const string& fileName)
+{
+    file = fopen(fileName.c_str(), "wb");
+    block.clear();
+    block.reserve(RANK_BLOCK_SIZE);
+    written = 0;
+    return file != NULL;
+}
+
+//----------------------------------------------------------------------
+//RankWriter::write - Adds a rank to the file, writing the block out once it is full
+//----------------------------------------------------------------------
+void RankWriter::write(uint64_t rank)
+{
+    block.push_back(rank);
+    written++;
+    
+    if(block.size() == RANK_BLOCK_SIZE)
+    {
+        fwrite(block.data(), sizeof(uint64_t), block.size(), file);
+        block.clear();
+    }
+}
+
+//----------------------------------------------------------------------
+//RankWriter::close - Writes out what is left and closes the file. Returns false if any write
+//                    failed, such as when the disk is full.
+//----------------------------------------------------------------------
+bool RankWriter::close()
+{
+    fwrite(block.data(), sizeof(uint64_t), block.size(), file);
+    block.clear();
+    
+    bool failed = ferror(file) != 0;
+    failed |= fclose(file) != 0;
+    file = NULL;
+    return !failed;
+}
+
+//----------------------------------------------------------------------
+//writeSortedRun - Sorts the ranks, drops repeats and writes them to a new run file. Empties
+//                 the ranks. Returns false if the file could not be written.
+//----------------------------------------------------------------------
+bool writeSortedRun(vector<uint64_t>& ranks, const string& fileName)
+{
+    sort(ranks.begin(), ranks.end());
+    ranks.erase(unique(ranks.begin(), ranks.end()), ranks.end());
+    
+    RankWriter run;
+    if(!run.open(fileName))
+    {
+        return false;
+    }
+    for(uint64_t rank : ranks)
+    {
+        run.write(rank);
+    }
+    
+    ranks.clear();
+    return run.close();
+}
+
+//----------------------------------------------------------------------
+//mergeSortedRuns - Merges sorted rank files into one sorted file without repeats, leaving out
+//                  any rank that is in one of the sorted exclude files. Says which file failed
+//                  and returns false if one could not be opened, read or written.
+//----------------------------------------------------------------------
+bool mergeSortedRuns(const vector<string>& runNames, const vector<string>& excludeNames, const string& outputName, uint64_t& written)
+{
+    uint64_t rank;
+    
+    //Holds the smallest rank not merged yet from each run, smallest first
+    vector<RankReader> runs(runNames.size());
+    priority_queue<pair<uint64_t, size_t>, vector<pair<uint64_t, size_t>>, greater<pair<uint64_t, size_t>>> heads;
+    
+    for(size_t r = 0; r < runs.size(); r++)
+    {
+        if(!runs[r].open(runNames[r]))
+        {
+            cout << "Could not open " << runNames[r] << endl;
+            return false;
+        }
+        if(runs[r].next(rank))
+        {
+            heads.push({rank, r});
+        }
+    }
+    
+    //Holds the smallest rank not passed yet in each exclude file
+    vector<RankReader> excludes(excludeNames.size());
+    vector<uint64_t> excludeRanks(excludeNames.size());
+    vector<bool> excludesLeft(excludeNames.size());
+    
+    for(size_t e = 0; e < excludes.size(); e++)
+    {
+        if(!excludes[e].open(excludeNames[e]))
+        {
+            cout << "Could not open " << excludeNames[e] << endl;
+            return false;
+        }
+        excludesLeft[e] = excludes[e].next(excludeRanks[e]);
+    }
+    
+    RankWriter output;
+    if(!output.open(outputName))
+    {
+        cout << "Could not create " << outputName << endl;
+        return false;
+    }
+    
+    bool anyMerged = false;
+    uint64_t lastRank = 0;
+    
+    while(!heads.empty())
+    {
+        pair<uint64_t, size_t> head = heads.top();
+        heads.pop();
+        
+        if(runs[head.second].next(rank))
+        {
+            heads.push({rank, head.second});
+        }
+        
+        //Skipping a rank another run already gave
+        if(anyMerged && head.first == lastRank)
+        {
+            continue;
+        }
+        anyMerged = true;
+        lastRank = head.first;
+        
+        //Moving each exclude file up to the rank and leaving it out if one has it
+        bool excluded = false;
+        for(size_t e = 0; e < excludes.size(); e++)
+        {
+            while(excludesLeft[e] && excludeRanks[e] < head.first)
+            {
+                excludesLeft[e] = excludes[e].next(excludeRanks[e]);
+            }
+            excluded |= excludesLeft[e] && excludeRanks[e] == head.first;
+        }
+        
+        if(!excluded)
+        {
+            output.write(head.first);
+        }
+    }
+    
+    //Closing everything, a failed read would have cut a file short
+    for(size_t r = 0; r < runs.size(); r++)
+    {
+        if(!runs[r].close())
+        {
+            cout << "Could not read " << runNames[r] << endl;
+            return false;
+        }
+    }
+    for(size_t e = 0; e < excludes.size(); e++)
+    {
+        if(!excludes[e].close())
+        {
+            cout << "Could not read " << excludeNames[e] << endl;
+            return false;
+        }
+    }
+    
+    written = output.written;
+    if(!output.close())
+    {
+        cout << "Could not write " << outputName << endl;
+        return false;
+    }
+    
+    return true;
+}
+
+//----------------------------------------------------------------------
+//runStateSpaceEnumeration - Breadth first search backwards from the solved puzzle over every
+//                           solvable puzzle, printing how many puzzles are at each depth. Each
+//                           layer is kept on disk as a sorted file of puzzle ranks, so the
+//                           space can be far larger than memory.
+//                           Usage: --enumerate DIRECTORY [--memory MB] [--keep]
+//
+//                           The children of a layer are collected in memory until --memory
+//                           is used, then sorted and written out as a run. The runs are merged
+//                           into the next layer, dropping repeats, along with the layer and
+//                           the one before it. A move's child is always in one of those two or
+//                           in the next layer, so anything found in them is not new. Every
+//                           file is read and written front to back in 1 MB blocks. Each open
+//                           file holds a block, so when there are more runs than --memory has
+//                           blocks for, or than RANK_MERGE_WIDTH, they are first merged a group
+//                           at a time into fewer, longer runs. With --keep the layer files are
+//                           left in the directory.
+//----------------------------------------------------------------------
+int runStateSpaceEnumeration(int argc, const char* argv[])
+{
+    if(argc < 3)
+    {
+        cout << "Usage: --enumerate DIRECTORY [--memory MB] [--keep]\n";
+        return 2;
+    }
+    
+    string directory = argv[2];
+    double memoryMegabytes = 256.0;
+    bool keepLayers = false;
+    
+    //Reading the command line options
+    for(int i = 3; i < argc; i++)
+    {
+        string option = argv[i];
+        
+        if(option == "--memory" && i + 1 < argc)
+        {
+            memoryMegabytes = atof(argv[++i]);
+        }
+        else if(option == "--keep")
+        {
+            keepLayers = true;
+        }
+        else
+        {
+            cout << "Unknown option " << option << endl;
+            return 2;
+        }
+    }
+    
+    //Holds the most children kept in memory before they are written out as a run
+    size_t runSize = max((size_t) RANK_BLOCK_SIZE, (size_t) (memoryMegabytes * 1048576.0 / sizeof(uint64_t)));
+    
+    //Holds the most runs merged at once, leaving blocks for the two layers and the output
+    size_t mergeWidth = (size_t) max(2.0, min((double) RANK_MERGE_WIDTH, memoryMegabytes * 1048576.0 / (RANK_BLOCK_SIZE * sizeof(uint64_t)) - 3));
+    
+    auto layerName = [&](int depth) { return directory + "/layer-" + to_string(depth) + ".bin"; };
+    auto runName = [&](int pass, size_t run) { return directory + "/run-" + to_string(pass) + "-" + to_string(run) + ".bin"; };
     
-    //Printing the move with the number of which move it is.
-    if (moveCount == -1)
+    //Starting from the solved puzzle
+    RankWriter firstLayer;
+    if(!firstLayer.open(layerName(0)))
     {
-        cout << "\tStarting State:\n";
-        outputFile << "\tStarting State:\n";
-        cout << "\tManhattan Distance:" << root->manhattanDistance << endl;
-        outputFile << "\tManhattan Distance:" << root->manhattanDistance << endl;
+        cout << "Could not create " << layerName(0) << endl;
+        return 2;
+    }
+    firstLayer.write(rankSolvablePuzzle(solvedPuzzle));
+    if(!firstLayer.close())
+    {
+        cout << "Could not write " << layerName(0) << endl;
+        return 2;
+    }
+    
+    auto start = chrono::steady_clock::now();
+    uint64_t totalPuzzles = 1;
+    int depth = 0;
+    
+    cout << right << setw(6) << "depth" << setw(16) << "puzzles" << setw(16) << "total" << setw(12) << "runs" << setw(12) << "seconds" << endl;
+    cout << setw(6) << 0 << setw(16) << 1 << setw(16) << 1 << setw(12) << 0 << setw(12) << 0.0 << endl;
+    
+    while(true)
+    {
+        //Making every child of the layer, written out in sorted runs
+        vector<uint64_t> children;
+        children.reserve(runSize);
+        vector<string> runNames;
+        int puzzleArray[PUZZLE_LENGTH];
+        
+        RankReader layer;
+        if(!layer.open(layerName(depth)))
+        {
+            cout << "Could not open " << layerName(depth) << endl;
+            return 2;
+        }
+        
+        uint64_t rank;
+        while(layer.next(rank))
+        {
+            unrankSolvablePuzzle(rank, puzzleArray);
+            int space = findEmptySpace(puzzleArray);
+            
+            //Holds the locations the space can move to
+            int moves[4];
+            int moveTotal = legalMoves(space, -1, moves);
+            
+            for(int m = 0; m < moveTotal; m++)
+            {
+                swap(puzzleArray[space], puzzleArray[moves[m]]);
+                children.push_back(rankSolvablePuzzle(puzzleArray));
+                swap(puzzleArray[space], puzzleArray[moves[m]]);
+            }
+            
+            if(children.size() + 4 > runSize)
+            {
+                runNames.push_back(runName(0, runNames.size()));
+                if(!writeSortedRun(children, runNames.back()))
+                {
+                    cout << "Could not write " << runNames.back() << endl;
+                    return 2;
+                }
+            }
+        }
+        
+        if(!layer.close())
+        {
+            cout << "Could not read " << layerName(depth) << endl;
+            return 2;
+        }
+        
+        if(!children.empty())
+        {
+            runNames.push_back(runName(0, runNames.size()));
+            if(!writeSortedRun(children, runNames.back()))
+            {
+                cout << "Could not write " << runNames.back() << endl;
+                return 2;
+            }
+        }
+        children.clear();
+        children.shrink_to_fit();
+        size_t runCount = runNames.size();
+        
+        //Merging the runs a group at a time until few enough are left to merge at once
+        for(int pass = 1; runNames.size() > mergeWidth; pass++)
+        {
+            vector<string> mergedNames;
+            
+            for(size_t first = 0; first < runNames.size(); first += mergeWidth)
+            {
+                vector<string> group(runNames.begin() + first, runNames.begin() + min(first + mergeWidth, runNames.size()));
+                mergedNames.push_back(runName(pass, mergedNames.size()));
+                
+                uint64_t mergedSize;
+                if(!mergeSortedRuns(group, vector<string>(), mergedNames.back(), mergedSize))
+                {
+                    return 2;
+                }
+                for(const string& name : group)
+                {
+                    remove(name.c_str());
+                }
+            }
+            
+            runNames.swap(mergedNames);
+        }
+        
+        //Merging what is left into the next layer, leaving out the layer and the one before it
+        vector<string> excludeNames(1, layerName(depth));
+        if(depth > 0)
+        {
+            excludeNames.push_back(layerName(depth - 1));
+        }
+        
+        uint64_t layerSize;
+        if(!mergeSortedRuns(runNames, excludeNames, layerName(depth + 1), layerSize))
+        {
+            return 2;
+        }
+        
+        //Cleaning up the runs and the layer no longer needed
+        for(const string& name : runNames)
+        {
+            remove(name.c_str());
+        }
+        
+        if(!keepLayers && depth > 0)
+        {
+            remove(layerName(depth - 1).c_str());
+        }
+        
+        //No new puzzles means every reachable puzzle has been found
+        if(layerSize == 0)
+        {
+            remove(layerName(depth + 1).c_str());
+            break;
+        }
+        
+        depth++;
+        totalPuzzles += layerSize;
+        
+        chrono::duration<double> elapsedTime = chrono::steady_clock::now() - start;
+        cout << setw(6) << depth << setw(16) << layerSize << setw(16) << totalPuzzles << setw(12) << runCount
+             << setw(12) << fixed << setprecision(2) << elapsedTime.count() << defaultfloat << endl;
     }
-    else
+    
+    if(!keepLayers)
     {
-        cout << "\tStep Number: " << moveCount + 1<< endl;
-        outputFile << "\tStep Number: " << moveCount + 1<< endl;
-        cout << "\tManhattan Distance:" << root->manhattanDistance << endl;
-        outputFile << "\tManhattan Distance:" << root->manhattanDistance << endl;
+        remove(layerName(depth - 1).c_str());
+        remove(layerName(depth).c_str());
     }
     
-    //Printing the current state
-    puzzlePrinter(root->currentState, outputFile);
+    cout << "\nReached " << totalPuzzles << " of " << solvablePuzzleCount() << " solvable puzzles, the farthest "
+         << depth << " moves from the goal\n";
+    
+    return totalPuzzles == solvablePuzzleCount() ? 0 : 1;
 }
 
 //----------------------------------------------------------------------
-//getInvCount - Function to count inversions in given array 'arr[]'
+//runSolverServer - Listens on a Unix domain socket and answers solve requests until killed.
+//                  The solution cache and each worker's tables stay warm between requests.
+//                  Usage: --serve SOCKET [--workers COUNT] [--time-limit SECONDS] [--memory MB]
+//
+//                  Each request is one line, "ID SEARCH PUZZLE [GOAL] [time=SECONDS] [memory=MB]",
+//                  where SEARCH is a benchmark name such as manhattan and PUZZLE is nine digits
+//                  such as 123456780. Every search stops at --time-limit and --memory, 10
+//                  seconds and 512 MB unless given, so one request cannot hold a worker forever
+//                  or use up the server's memory. time= and memory= can lower them for one
+//                  request, but not raise them. Each answer is one line starting with the
+//                  request's ID, sent as soon as it is ready, so answers can come back in a
+//                  different order than they were sent:
+//                      ID ok MOVES NODES MICROSECONDS PATH   (PATH moves the space U, D, L or R)
+//                      ID none NODES MICROSECONDS REASON     (REASON is why the search stopped)
+//                      ID error MESSAGE
+//                  The line "stats" is answered with the latency of each search, ending in "end".
 //----------------------------------------------------------------------
-int getInvCount(int puzzleArray[])
+int runSolverServer(int argc, const char* argv[])
 {
-    //Holds the number of inversions
-    int inv_count = 0;
+    if(argc < 3)
+    {
+        cout << "Usage: --serve SOCKET [--workers COUNT] [--time-limit SECONDS] [--memory MB]\n";
+        return 2;
+    }
     
+    string socketPath = argv[2];
+    int workerCount = max(1, (int) thread::hardware_concurrency());
     
-    for (int i = 0; i < PUZZLE_LENGTH - 1; i++)
+    //Reading the command line options
+    for(int i = 3; i < argc; i++)
     {
-        for (int j = i + 1; j < PUZZLE_LENGTH; j++)
+        string option = argv[i];
+        
+        if(option == "--workers" && i + 1 < argc)
         {
-            // Value 0 is used for empty space
-            if (puzzleArray[j] && puzzleArray[i] &&  puzzleArray[i] > puzzleArray[j])
-            {
-                //Incrementing the inversion count
-                inv_count++;
-            }
+            workerCount = max(1, atoi(argv[++i]));
+        }
+        else if(option == "--time-limit" && i + 1 < argc)
+        {
+            serverTimeLimit = atof(argv[++i]);
+        }
+        else if(option == "--memory" && i + 1 < argc)
+        {
+            serverMaxMemory = (size_t) (atof(argv[++i]) * 1048576.0);
+        }
+        else
+        {
+            cout << "Unknown option " << option << endl;
+            return 2;
         }
     }
     
-    //Returns the number of inversions
-    return inv_count;
-}
-
-//----------------------------------------------------------------------
-//isSolvable - This function returns true if given puzzle is solvable.
-//----------------------------------------------------------------------
-bool isSolvable(int puzzleArray[])
-{
-    // Count inversions in given 8 puzzle
-    int invCount = getInvCount((int *)puzzleArray);
-    
-    // return true if inversion count is even.
-    return (invCount % 2 == 0);
-}
-
-//----------------------------------------------------------------------
-//useSameArray - This function asks the user if they would like to use the same starting array for a new search algorithm
-//----------------------------------------------------------------------
-void useSameArray(int puzzleArray[], fstream& outputFile)
-{
-    char useAgain = 0;
-    
-    cout << "Would you like to use the same starting puzzle\n";
-    cout << "in a different search?\n";
-    cout << "Please enter 'Y' for YES or 'N' for NO.\n";
-    cout << "Enter Here: ";
-    cin >> useAgain;
-    
-    //Verifies input is Y or N. IF NOT, requests new input
-    while(useAgain != 'Y' && useAgain != 'y' && useAgain != 'N' && useAgain != 'n' )
+    if(serverTimeLimit <= 0.0 || serverMaxMemory == 0)
     {
-        cout << "\nPlease enter a correct selection.\n";
-        cout << "Enter Here:  ";
-        cin >> useAgain;
+        cout << "The time limit and memory must be more than 0" << endl;
+        return 2;
     }
     
-    //If the user input Y for yes, call the solvint options menu.
-    if (useAgain == 'y' || useAgain == 'Y')
+    //Creating the socket, replacing one left behind by an earlier run
+    sockaddr_un address;
+    memset(&address, 0, sizeof address);
+    address.sun_family = AF_UNIX;
+    if(socketPath.size() >= sizeof address.sun_path)
     {
-        cout << endl << endl;
-        howToSolveMenu(puzzleArray, outputFile);
+        cout << "Socket path is too long: " << socketPath << endl;
+        return 2;
     }
-    else //Else send to main menu
+    strcpy(address.sun_path, socketPath.c_str());
+    unlink(socketPath.c_str());
+    
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(listener < 0 || ::bind(listener, (sockaddr*) &address, sizeof address) < 0 || listen(listener, SOMAXCONN) < 0)
     {
-        cout << endl << endl;
-        pressToContinue(outputFile);
+        cout << "Could not listen on " << socketPath << ": " << strerror(errno) << endl;
+        return 1;
     }
-}
-
-//----------------------------------------------------------------------
-//getManhattenDistance - This function returns the absolute value of how many moves the puzzle is out of place
-//----------------------------------------------------------------------
-int getManhattanDistance(int puzzleArray[], fstream& outputFile)
-{
-    // Function variables
-    int manhattanDistance = 0;
     
-    //Holds the row and column of the searched value in the for loop.
-    int puzzleRow = 0;
-    int puzzleColumn = 0;
+    //Starting the workers
+    for(int w = 0; w < workerCount; w++)
+    {
+        thread(serverWorker).detach();
+    }
     
-    //Holds the row and column of the searched value in the solvedPuzzle
-    int solvedRow = 0;
-    int solvedColumn = 0;
+    cout << "Listening on " << socketPath << " with " << workerCount << " workers, " << serverTimeLimit
+         << "s and " << serverMaxMemory / 1048576 << " MB per search" << endl;
     
-    // For loop used to calculate the Manhattan distance
-    for (int x = 0; x < PUZZLE_LENGTH; x++)
+    //Giving each client its own reader so a slow client cannot hold up the others
+    while(true)
     {
-        //Setting the location of the searched array row and column
-        getRowAndColumn(puzzleArray, x, puzzleRow, puzzleColumn);
-        
-        //Setting the location of the solvedState row and column
-        getRowAndColumn(solvedPuzzle, x, solvedRow, solvedColumn);
-        
-        //Calculating the distance
-        manhattanDistance = manhattanDistance + abs((puzzleRow - solvedRow)) + abs((puzzleColumn - solvedColumn));
+        int client = accept(listener, NULL, NULL);
+        if(client < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
         
+        thread(serverReader, make_shared<ServerConnection>(client)).detach();
     }
     
-    //Returns the manhattenDistance that was calculated
-    return manhattanDistance;
+    cout << "Stopped accepting clients: " << strerror(errno) << endl;
+    close(listener);
+    unlink(socketPath.c_str());
+    
+    return 1;
 }
 
 //----------------------------------------------------------------------
-//getRowandColumn - This function takes the location of a value and returns a row and column.
+//serverReader - Reads requests from a client. Every complete line in a read is checked and
+//               queued together, so a burst of requests takes the queue lock once. A client
+//               that sends more than SERVER_MAX_REQUEST bytes without an end of line is sent
+//               an error and disconnected.
 //----------------------------------------------------------------------
-void getRowAndColumn(int puzzleArray[], int location, int& puzzleRow, int& puzzleColumn)
+void serverReader(shared_ptr<ServerConnection> connection)
 {
-    // For loop used to get the index of the array and return the location of the column and row.
-    for (int x = 0; x < PUZZLE_LENGTH; x++)
+    //Holds a request that has not been read up to its end of line yet
+    string pending;
+    
+    vector<char> buffer(SERVER_READ_SIZE);
+    while(true)
     {
-        //If statement to set the value for each row and column once the for loop locatates the correct value
-        if (puzzleArray[x] == solvedPuzzle[location])
+        ssize_t bytesRead = recv(connection->socket, buffer.data(), buffer.size(), 0);
+        if(bytesRead <= 0)
+        {
+            break;
+        }
+        
+        auto received = chrono::steady_clock::now();
+        pending.append(buffer.data(), bytesRead);
+        
+        vector<ServerJob> batch;
+        size_t lineStart = 0;
+        size_t lineEnd = 0;
+        while((lineEnd = pending.find('\n', lineStart)) != string::npos)
         {
-            switch (x)
+            istringstream line(pending.substr(lineStart, lineEnd - lineStart));
+            lineStart = lineEnd + 1;
+            
+            string id;
+            string searchName;
+            string puzzleText;
+            line >> id >> searchName >> puzzleText;
+            
+            if(id.empty())
             {
-                case 0: // Row 0, Column 0
-                {
-                    puzzleRow = 0;
-                    puzzleColumn = 0;
-                    break;
-                }
-                    
-                case 1: // Row 0, Column 1
-                {
-                    puzzleRow = 0;
-                    puzzleColumn = 1;
-                    break;
-                }
-                    
-                case 2: // Row 0, Column 2
-                {
-                    puzzleRow = 0;
-                    puzzleColumn = 2;
-                    break;
-                }
-                    
-                case 3: // Row 1, Column 0
-                {
-                    puzzleRow = 1;
-                    puzzleColumn = 0;
-                    break;
-                }
-                    
-                case 4: // Row 1, Column 1
+                continue;
+            }
+            if(id == "stats")
+            {
+                serverSend(*connection, serverStats());
+                continue;
+            }
+            
+            ServerJob job;
+            job.connection = connection;
+            job.id = id;
+            job.timeLimit = serverTimeLimit;
+            job.maxMemory = serverMaxMemory;
+            job.received = received;
+            
+            //Reading the goal and any limits, which may only lower the server's own
+            string goalText;
+            string extra;
+            string badField;
+            while(line >> extra)
+            {
+                if(extra.compare(0, 5, "time=") == 0 && atof(extra.c_str() + 5) > 0.0)
                 {
-                    puzzleRow = 1;
-                    puzzleColumn = 1;
-                    break;
+                    job.timeLimit = min(job.timeLimit, atof(extra.c_str() + 5));
                 }
-                    
-                case 5: // Row 1, Column 2
+                else if(extra.compare(0, 7, "memory=") == 0 && atof(extra.c_str() + 7) > 0.0)
                 {
-                    puzzleRow = 1;
-                    puzzleColumn = 2;
-                    
-                    break;
+                    job.maxMemory = min(job.maxMemory, (size_t) (atof(extra.c_str() + 7) * 1048576.0));
                 }
-                    
-                case 6: // Row 2, Column 0
+                else if(goalText.empty() && extra.find('=') == string::npos)
                 {
-                    puzzleRow = 2;
-                    puzzleColumn = 0;
-                    break;
+                    goalText = extra;
                 }
-                    
-                case 7: // Row 2, Column 1
+                else
                 {
-                    puzzleRow = 2;
-                    puzzleColumn = 1;
-                    break;
+                    badField = extra;
                 }
-                    
-                case 8: // Row 2, Column 2
+            }
+            
+            if(!badField.empty())
+            {
+                serverSend(*connection, id + " error unknown field " + badField + "\n");
+                continue;
+            }
+            
+            //Finding the search by its benchmark name
+            int solver = -1;
+            for(int s = 0; s <= MEMORY_BOUNDED; s++)
+            {
+                if(searchName == solverTable[s].name)
                 {
-                    puzzleRow = 2;
-                    puzzleColumn = 2;
-                    break;
+                    solver = s;
                 }
-                    
-                default:
+            }
+            
+            if(solver == -1)
+            {
+                serverSend(*connection, id + " error unknown search " + searchName + "\n");
+                continue;
+            }
+            if(!parseServerBoard(puzzleText, job.board))
+            {
+                serverSend(*connection, id + " error puzzle must use every tile once each\n");
+                continue;
+            }
+            
+            //Solving toward the standard goal unless the request names one
+            job.goal = makeBoard(solvedPuzzle);
+            if(!goalText.empty() && !parseServerBoard(goalText, job.goal))
+            {
+                serverSend(*connection, id + " error goal must use every tile once each\n");
+                continue;
+            }
+            if(!canReachGoal(job.board.tiles, job.goal.tiles))
+            {
+                serverSend(*connection, id + " error puzzle is not solvable\n");
+                continue;
+            }
+            
+            job.algorithm = solverTable[solver].algorithm;
+            batch.push_back(job);
+        }
+        pending.erase(0, lineStart);
+        
+        //Queueing the whole batch at once
+        if(!batch.empty())
+        {
+            {
+                lock_guard<mutex> lock(serverJobMutex);
+                for(ServerJob& job : batch)
                 {
-                    break;
+                    serverJobs.push_back(move(job));
                 }
             }
+            serverJobReady.notify_all();
+        }
+        
+        //Dropping a client whose request has no end in sight, so it cannot fill the server's memory
+        if(pending.size() > SERVER_MAX_REQUEST)
+        {
+            serverSend(*connection, "error request longer than " + to_string(SERVER_MAX_REQUEST) + " bytes\n");
+            shutdown(connection->socket, SHUT_RDWR);
+            break;
+        }
+    }
+}
+
+//----------------------------------------------------------------------
+//serverWorker - Takes requests off the queue, solves them and answers the client
+//----------------------------------------------------------------------
+void serverWorker()
+{
+    //Holds the worker's own seen list and goal, reused from one request to the next
+    SearchContext context;
+    
+    while(true)
+    {
+        ServerJob job;
+        {
+            unique_lock<mutex> lock(serverJobMutex);
+            serverJobReady.wait(lock, [] { return !serverJobs.empty(); });
+            job = move(serverJobs.front());
+            serverJobs.pop_front();
+        }
+        
+        //Starting the request's time limit when its search starts, not while it waited
+        Limits limits;
+        limits.deadline = chrono::steady_clock::now() + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(job.timeLimit));
+        limits.timeLimit = min(limits.timeLimit, job.timeLimit);
+        limits.maxMemory = job.maxMemory;
+        
+        SolveResult result = solve(job.board, job.goal, job.algorithm, limits, context);
+        
+        ostringstream answer;
+        uint64_t solveMicroseconds = (uint64_t) (result.elapsedTime * 1e6);
+        if(result.solved)
+        {
+            answer << job.id << " ok " << result.path.size() - 1 << " " << result.totalNodeCount << " "
+                   << solveMicroseconds << " " << solutionMoves(result) << "\n";
+        }
+        else
+        {
+            //Naming why the search stopped as one word, such as deadline-reached
+            string reason = stopReasonName(result.stopReason);
+            replace(reason.begin(), reason.end(), ' ', '-');
+            
+            answer << job.id << " none " << result.totalNodeCount << " " << solveMicroseconds << " " << reason << "\n";
+        }
+        serverSend(*job.connection, answer.str());
+        
+        //Recording the time from reading the request to answering it
+        auto latency = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - job.received);
+        serverLatency[job.algorithm].record((uint64_t) latency.count());
+    }
+}
+
+//----------------------------------------------------------------------
+//serverSend - Writes a whole answer to a client. A client that has gone away is ignored.
+//----------------------------------------------------------------------
+void serverSend(ServerConnection& connection, const string& message)
+{
+    lock_guard<mutex> lock(connection.writeMutex);
+    
+    size_t sent = 0;
+    while(sent < message.size())
+    {
+        ssize_t written = send(connection.socket, message.data() + sent, message.size() - sent, MSG_NOSIGNAL);
+        if(written <= 0)
+        {
+            if(written < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            return;
         }
+        sent += written;
     }
 }
 
 //----------------------------------------------------------------------
-//arrayToIntConverter - Will take a int array and convert it into a single int number.
-//                      that will be used with the c++ list.
+//parseServerBoard - Reads a puzzle written as one character per square, the digits 0 to 9
+//                   then the letters a, b, c and on for tiles past 9. Returns false unless
+//                   every tile is used exactly once.
 //----------------------------------------------------------------------
-int arrayToIntConverter(int puzzleArray[])
+bool parseServerBoard(const string& puzzleText, Board& board)
 {
-    int arrayInt = 0;
+    if(puzzleText.size() != PUZZLE_LENGTH)
+    {
+        return false;
+    }
+    
+    bool used[PUZZLE_LENGTH] = {false};
+    for(int i = 0; i < PUZZLE_LENGTH; i++)
+    {
+        int tile = isdigit((unsigned char) puzzleText[i]) ? puzzleText[i] - '0' : puzzleText[i] - 'a' + 10;
+        if(tile < 0 || tile >= PUZZLE_LENGTH || used[tile])
+        {
+            return false;
+        }
+        
+        used[tile] = true;
+        board.tiles[i] = tile;
+    }
+    
+    return true;
+}
 
-    for (int i = 0; i < PUZZLE_LENGTH; i++)
+//----------------------------------------------------------------------
+//solutionMoves - Writes a solution as the direction the space moves each step, U, D, L or R
+//----------------------------------------------------------------------
+string solutionMoves(const SolveResult& result)
+{
+    string moves;
+    
+    for(size_t step = 1; step < result.path.size(); step++)
     {
-        arrayInt *= 10;
-        arrayInt += puzzleArray[i];
+        int change = result.path[step].spaceLocation - result.path[step - 1].spaceLocation;
+        moves += change == -PUZZLE_WIDTH ? 'U' : change == PUZZLE_WIDTH ? 'D' : change == -1 ? 'L' : 'R';
     }
     
-    return arrayInt;
+    return moves;
 }
 
 //----------------------------------------------------------------------
-//puzzleInvalidMenu - This menu is called if the input puzzle cannot be solved
+//serverStats - Writes the request count and latency percentiles of each search that has
+//              been used, plus the queue length and the solution cache counters
 //----------------------------------------------------------------------
-void puzzleInvalidMenu(fstream& outputFile, int puzzleArray[])
+string serverStats()
 {
-    int userSelection = 0;
+    ostringstream stats;
     
-    cout << "Please make a selection:" << endl;
-    cout << "\t1: Attempt puzzle." << endl;
-    cout << "\t2: Input a new puzzle." << endl;
-    cout << "\t3: Exit to main menu." << endl << endl;
+    size_t queued = 0;
+    {
+        lock_guard<mutex> lock(serverJobMutex);
+        queued = serverJobs.size();
+    }
     
-    cin >> userSelection;
+    stats << "stats queued=" << queued << " cacheHits=" << solutionCache.hits << " cacheMisses=" << solutionCache.misses << "\n";
     
-    //Verifies input is an integer. IF NOT, requests new input
-    while(!integerVerify(userSelection))
+    for(int s = 0; s <= MEMORY_BOUNDED; s++)
     {
-        cout << "Please Enter a Selection: ";
-        cin >> userSelection;
+        const LatencyHistogram& histogram = serverLatency[s];
+        uint64_t count = histogram.count;
+        if(count == 0)
+        {
+            continue;
+        }
+        
+        stats << "stats " << solverTable[s].name << " count=" << count
+              << " meanUs=" << histogram.totalMicroseconds / count
+              << " p50Us=" << histogram.percentile(0.50)
+              << " p90Us=" << histogram.percentile(0.90)
+              << " p99Us=" << histogram.percentile(0.99)
+              << " maxUs=" << histogram.maximumMicroseconds << "\n";
     }
     
-    //Spacer Line
-    cout << endl;
+    stats << "end\n";
     
-    //calling the switch
-    puzzleInvalidMenuSwitch(userSelection, puzzleArray, outputFile);
+    return stats.str();
 }
 
 //----------------------------------------------------------------------
-//puzzleInvalidMenuSwitch - This is the switch for the invalid menu
+//LatencyHistogram::record - Counts one answer that took the given number of microseconds
 //----------------------------------------------------------------------
-void puzzleInvalidMenuSwitch(int userSelection, int puzzleArray[], fstream& outputFile)
+void LatencyHistogram::record(uint64_t microseconds)
 {
-    //Setting up the switch for the user selection
-    switch (userSelection)
+    //Finding the power of two bucket the latency falls in
+    int bucket = 0;
+    while(bucket < SERVER_HISTOGRAM_BUCKETS - 1 && (microseconds >> (bucket + 1)) != 0)
     {
-        case 1://Breadth First Search
+        bucket++;
+    }
+    
+    buckets[bucket].fetch_add(1, memory_order_relaxed);
+    count.fetch_add(1, memory_order_relaxed);
+    totalMicroseconds.fetch_add(microseconds, memory_order_relaxed);
+    
+    uint64_t maximum = maximumMicroseconds.load(memory_order_relaxed);
+    while(microseconds > maximum && !maximumMicroseconds.compare_exchange_weak(maximum, microseconds, memory_order_relaxed))
+    {
+    }
+}
+
+//----------------------------------------------------------------------
+//LatencyHistogram::percentile - Returns the top of the bucket holding the given fraction of
+//                               answers, or the slowest answer if that is lower, so the true
+//                               percentile is at most this many microseconds
+//----------------------------------------------------------------------
+uint64_t LatencyHistogram::percentile(double fraction) const
+{
+    uint64_t total = count.load(memory_order_relaxed);
+    uint64_t target = max((uint64_t) 1, (uint64_t) (fraction * total + 0.999999));
+    
+    uint64_t seen = 0;
+    for(int bucket = 0; bucket < SERVER_HISTOGRAM_BUCKETS; bucket++)
+    {
+        seen += buckets[bucket].load(memory_order_relaxed);
+        if(seen >= target)
         {
-            howToSolveMenu(puzzleArray, outputFile);
-            break;
+            return min((uint64_t) 1 << (bucket + 1), maximumMicroseconds.load(memory_order_relaxed));
         }
-        case 2://Depth First Search
+    }
+    
+    return maximumMicroseconds.load(memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------
+//runTwoBitDepthTable - Builds the two bit depth table over every solvable puzzle and prints how
+//                      many puzzles are at each depth. On boards of up to ten squares, where the
+//                      byte depth table takes a few seconds at most, random puzzles are then
+//                      checked against it.
+//                      Usage: --depth-table [--threads N]
+//----------------------------------------------------------------------
+int runTwoBitDepthTable(int argc, const char* argv[])
+{
+    int threadCount = max(1, (int) thread::hardware_concurrency());
+    
+    //Reading the command line options
+    for(int i = 2; i < argc; i++)
+    {
+        string option = argv[i];
+        
+        if(option == "--threads" && i + 1 < argc)
         {
-            puzzleEntry(outputFile);
-            break;
+            threadCount = max(1, atoi(argv[++i]));
         }
-        case 3://A* using the number of misplaced tiles.
+        else
         {
-            puzzleMainMenu(outputFile);
-            break;
+            cout << "Unknown option " << option << endl;
+            return 2;
         }
-        default://Invalid selection
+    }
+    
+    //Refusing boards whose table cannot fit in memory before allocating any of it
+    double tableMegabytes = (solvablePuzzleCount() + 3) / 4 / 1048576.0;
+    if(tableMegabytes > TWO_BIT_TABLE_MAX_MB)
+    {
+        cout << "The table for " << solvablePuzzleCount() << " puzzles needs " << tableMegabytes
+             << " MB, more than " << TWO_BIT_TABLE_MAX_MB << " MB. Use --enumerate, which keeps its layers on disk." << endl;
+        return 2;
+    }
+    
+    cout << "Building the depth table for " << solvablePuzzleCount() << " puzzles in "
+         << tableMegabytes << " MB with " << threadCount << " threads\n\n";
+    
+    auto start = chrono::steady_clock::now();
+    TwoBitDepthTable table;
+    try
+    {
+        buildTwoBitDepthTable(table, threadCount);
+    }
+    catch(const bad_alloc&)
+    {
+        cout << "Could not allocate " << tableMegabytes << " MB for the table. Use --enumerate, which keeps its layers on disk." << endl;
+        return 2;
+    }
+    chrono::duration<double> elapsedTime = chrono::steady_clock::now() - start;
+    
+    uint64_t totalPuzzles = 0;
+    cout << right << setw(6) << "depth" << setw(16) << "puzzles" << setw(16) << "total" << endl;
+    
+    for(size_t depth = 0; depth < table.layerSizes.size(); depth++)
+    {
+        totalPuzzles += table.layerSizes[depth];
+        cout << setw(6) << depth << setw(16) << table.layerSizes[depth] << setw(16) << totalPuzzles << endl;
+    }
+    
+    cout << "\nReached " << totalPuzzles << " of " << solvablePuzzleCount() << " solvable puzzles, the farthest "
+         << table.layerSizes.size() - 1 << " moves from the goal, in " << fixed << setprecision(2)
+         << elapsedTime.count() << "s with " << table.expansions << " expansions\n" << defaultfloat;
+    
+    //Checking random puzzles against the byte table
+    uint64_t seed = 1;
+    int puzzleArray[PUZZLE_LENGTH];
+    
+    for(int check = 0; check < 1000 && PUZZLE_LENGTH <= 10; check++)
+    {
+        randomSolvablePuzzle(puzzleArray, seed);
+        
+        if(twoBitOptimalDepth(table, puzzleArray) != optimalDepth(puzzleArray))
         {
-            cout << "\t::Invalid Selection::\n";
-            puzzleInvalidMenu(outputFile, puzzleArray);
-            break;
+            cout << "The two bit table disagrees with the byte table on puzzle rank "
+                 << rankSolvablePuzzle(puzzleArray) << endl;
+            return 1;
         }
     }
+    
+    return totalPuzzles == solvablePuzzleCount() ? 0 : 1;
 }
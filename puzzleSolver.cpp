@@ -0,0 +1,2976 @@
+/*
+The slider puzzle solver. This file holds the searches, heuristics and puzzle
+helpers declared in puzzleSolver.h. Nothing in here reads from or prints to
+the console or a file.
+*/
+
+#include "puzzleSolver.h"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <cstring>
+#include <queue>
+#include <set>
+#include <stack>
+#include <thread>
+
+using namespace std;
+
+//The search template below is put together from one policy of each kind. A frontier policy
+//holds the live states, a heuristic policy scores each state, and a duplicate policy decides
+//when puzzles are marked as seen and tested for the goal.
+
+//Frontier that hands back the oldest state first
+struct FifoFrontier
+{
+    queue<State*> states;
+    
+    void push(State* state, int) { states.push(state); }
+    State* pop() { State* state = states.front(); states.pop(); return state; }
+    bool empty() const { return states.empty(); }
+    size_t size() const { return states.size(); }
+};
+
+//Frontier that hands back the newest state first
+struct LifoFrontier
+{
+    stack<State*> states;
+    
+    void push(State* state, int) { states.push(state); }
+    State* pop() { State* state = states.top(); states.pop(); return state; }
+    bool empty() const { return states.empty(); }
+    size_t size() const { return states.size(); }
+};
+
+//Frontier that hands back the best state by a comparison object such as comp or mdcomp
+template <class Compare>
+struct HeapFrontier
+{
+    priority_queue<State*, vector<State*>, Compare> states;
+    
+    void push(State* state, int) { states.push(state); }
+    State* pop() { State* state = states.top(); states.pop(); return state; }
+    bool empty() const { return states.empty(); }
+    size_t size() const { return states.size(); }
+};
+
+//Frontier that holds each board at most once. It is a binary heap ordered by a comparison
+//object, paired with a table from the packed board to the state waiting for it, and each state
+//keeps its place in the heap in frontierSlot. A board pushed again takes the waiting state's
+//place only if it is better, then moves up the heap (decrease key). Otherwise it is dropped,
+//so the heap never fills with stale copies of a board. The table is open addressing with
+//linear probing, at most half full, and a popped board's slot is filled by shifting the
+//probes after it back rather than leaving a marker.
+template <class Compare>
+struct IndexedHeapFrontier
+{
+    struct TableEntry
+    {
+        PackedPuzzle puzzle;            //Holds the waiting board, packed
+        State* state;                   //Holds the state waiting for it, NULL when empty
+    };
+    
+    vector<State*> heap;
+    vector<TableEntry> table;
+    size_t mask = 0;
+    Compare worse;
+    
+    void push(State* state, int)
+    {
+        if(2 * (heap.size() + 1) > table.size())
+        {
+            grow();
+        }
+        
+        PackedPuzzle packedPuzzle = arrayToIntConverter(state->currentState);
+        size_t slot = tableSlot(packedPuzzle);
+        while(table[slot].state != NULL && table[slot].puzzle != packedPuzzle)
+        {
+            slot = (slot + 1) & mask;
+        }
+        
+        if(table[slot].state == NULL)
+        {
+            table[slot] = {packedPuzzle, state};
+            state->frontierSlot = (int) heap.size();
+            heap.push_back(state);
+        }
+        else
+        {
+            //Keeping the waiting state unless the new one is better
+            State* waitingState = table[slot].state;
+            if(!worse(waitingState, state))
+            {
+                return;
+            }
+            
+            state->frontierSlot = waitingState->frontierSlot;
+            waitingState->frontierSlot = -1;
+            heap[state->frontierSlot] = state;
+            table[slot].state = state;
+        }
+        
+        siftUp(state->frontierSlot);
+    }
+    State* pop()
+    {
+        State* state = heap[0];
+        removeFromTable(state);
+        state->frontierSlot = -1;
+        
+        //Filling the top with the last state and letting it sink to its place
+        heap[0] = heap.back();
+        heap.pop_back();
+        if(!heap.empty())
+        {
+            heap[0]->frontierSlot = 0;
+            siftDown(0);
+        }
+        return state;
+    }
+    bool empty() const { return heap.empty(); }
+    size_t size() const { return heap.size(); }
+    
+    size_t tableSlot(PackedPuzzle packedPuzzle) const
+    {
+        uint64_t hash = hashPuzzle(packedPuzzle);
+        return (size_t) (hash >> 32) & mask;
+    }
+    void grow()
+    {
+        vector<TableEntry> oldTable;
+        oldTable.swap(table);
+        table.assign(max((size_t) 1024, 2 * oldTable.size()), TableEntry{0, NULL});
+        mask = table.size() - 1;
+        
+        for(const TableEntry& entry : oldTable)
+        {
+            if(entry.state != NULL)
+            {
+                size_t slot = tableSlot(entry.puzzle);
+                while(table[slot].state != NULL)
+                {
+                    slot = (slot + 1) & mask;
+                }
+                table[slot] = entry;
+            }
+        }
+    }
+    void removeFromTable(State* state)
+    {
+        size_t slot = tableSlot(arrayToIntConverter(state->currentState));
+        while(table[slot].state != state)
+        {
+            slot = (slot + 1) & mask;
+        }
+        
+        //Moving back any later board whose probe passed over the emptied slot
+        size_t next = (slot + 1) & mask;
+        while(table[next].state != NULL)
+        {
+            size_t home = tableSlot(table[next].puzzle);
+            if(((next - home) & mask) >= ((next - slot) & mask))
+            {
+                table[slot] = table[next];
+                slot = next;
+            }
+            next = (next + 1) & mask;
+        }
+        table[slot].state = NULL;
+    }
+    void siftUp(int slot)
+    {
+        State* state = heap[slot];
+        while(slot > 0 && worse(heap[(slot - 1) / 2], state))
+        {
+            heap[slot] = heap[(slot - 1) / 2];
+            heap[slot]->frontierSlot = slot;
+            slot = (slot - 1) / 2;
+        }
+        heap[slot] = state;
+        state->frontierSlot = slot;
+    }
+    void siftDown(int slot)
+    {
+        State* state = heap[slot];
+        int count = (int) heap.size();
+        while(2 * slot + 1 < count)
+        {
+            //Picking the better child
+            int child = 2 * slot + 1;
+            if(child + 1 < count && worse(heap[child], heap[child + 1]))
+            {
+                child++;
+            }
+            if(!worse(state, heap[child]))
+            {
+                break;
+            }
+            
+            heap[slot] = heap[child];
+            heap[slot]->frontierSlot = slot;
+            slot = child;
+        }
+        heap[slot] = state;
+        state->frontierSlot = slot;
+    }
+};
+
+//Orders states by their moves so far plus manhatten distance, and on a tie takes the state
+//with more moves first, as it is likely closer to the goal.
+struct deeperMdcomp
+{
+    bool operator()(const State* lhs, const State* rhs) const
+    {
+        if(lhs->manhattanDistance != rhs->manhattanDistance)
+        {
+            return lhs->manhattanDistance > rhs->manhattanDistance;
+        }
+        return lhs->moveCount < rhs->moveCount;
+    }
+};
+
+//Heuristic that scores every state the same, for the blind searches. stored() hands back the
+//score a state was given when it was pushed, -1 when the search has no scores to report.
+struct NoHeuristic
+{
+    static int score(State*, const SearchContext&) { return 0; }
+    static int stored(const State*) { return -1; }
+};
+
+//Heuristic that scores a state by its number of misplaced tiles
+struct MisplacedTilesHeuristic
+{
+    static int score(State*, const SearchContext&);
+    static int stored(const State* state) { return state->misplacedTiles; }
+};
+
+//Heuristic that scores a state by its moves so far plus its manhatten distance
+struct ManhattanHeuristic
+{
+    static int score(State*, const SearchContext&);
+    static int stored(const State* state) { return state->manhattanDistance; }
+};
+
+//Marks puzzles as seen and tests them for the goal when they are created. Suits the blind
+//searches, where the first path found to a puzzle is the one kept.
+struct SeenOnGeneration
+{
+    static const bool markOnGeneration = true;
+};
+
+//Marks puzzles as expanded and tests them for the goal when they come off the frontier, so a
+//better path found later can still be used. Needed for A* to stay optimal.
+struct ClosedOnExpansion
+{
+    static const bool markOnGeneration = false;
+};
+
+//This is the struct that holds how a goal is carried onto the standard goal. The board is first
+//turned or flipped by one of the eight symmetries of the square, which keeps every move a move,
+//so that the goal's empty space lands where the standard goal has it. The tiles are then
+//renamed so the turned goal reads as the standard goal.
+struct GoalFrame
+{
+    int position[PUZZLE_LENGTH];        //Holds where each square lands in the standard frame
+    int tileName[PUZZLE_LENGTH];        //Holds the name each tile is given in the standard frame
+    int originalTile[PUZZLE_LENGTH];    //Holds the tile each name in the standard frame came from
+};
+
+//This is the struct every search uses to check its Limits once per expansion. The node count is
+//checked each time, the clock, memory and cancellation token only every SEARCH_CHECK_INTERVAL
+//expansions, so the check costs a compare and a decrement on most expansions. The same every
+//SEARCH_CHECK_INTERVAL expansions it publishes the search's counters to limits.progress.
+struct SearchLimiter
+{
+    const Limits& limits;
+    int untilCheck = SEARCH_CHECK_INTERVAL;
+    
+    SearchLimiter(const Limits& searchLimits) : limits(searchLimits) {}
+    
+    //Returns true and records why in result once a limit is reached. memoryBytes is only called
+    //when the memory limit is checked or the progress is published. openSize, depth and bound
+    //describe where the search is for the progress, bound being -1 when there is none.
+    template <class MemoryEstimate>
+    bool shouldStop(SearchResult& result, MemoryEstimate memoryBytes, size_t openSize, int depth, int bound)
+    {
+        if(limits.maxNodes > 0 && result.totalNodeCount >= limits.maxNodes)
+        {
+            result.stopReason = NODE_LIMIT_REACHED;
+            return true;
+        }
+        
+        if(--untilCheck > 0)
+        {
+            return false;
+        }
+        untilCheck = SEARCH_CHECK_INTERVAL;
+        
+        //Publishing the counters, relaxed as whoever reads them only shows them
+        if(limits.progress != NULL)
+        {
+            limits.progress->nodes.store(result.totalNodeCount, memory_order_relaxed);
+            limits.progress->openSize.store(openSize, memory_order_relaxed);
+            limits.progress->depth.store(depth, memory_order_relaxed);
+            limits.progress->bound.store(bound, memory_order_relaxed);
+            limits.progress->memoryBytes.store(memoryBytes(), memory_order_relaxed);
+        }
+        
+        if(limits.cancellation != NULL && limits.cancellation->isCancelled())
+        {
+            result.stopReason = SEARCH_CANCELLED;
+        }
+        else if(limits.maxMemory > 0 && memoryBytes() >= limits.maxMemory)
+        {
+            result.stopReason = MEMORY_LIMIT_REACHED;
+        }
+        else if(limits.deadline != chrono::steady_clock::time_point::max() && chrono::steady_clock::now() >= limits.deadline)
+        {
+            result.stopReason = DEADLINE_REACHED;
+        }
+        
+        return result.stopReason != NOT_STOPPED;
+    }
+};
+
+//---------------------------------------------------------------------------------------
+//makeSolvedPuzzle - Lays the tiles out in order with the empty space last
+//---------------------------------------------------------------------------------------
+constexpr Board makeSolvedPuzzle()
+{
+    Board board{};
+    for(int i = 0; i < PUZZLE_LENGTH; i++)
+    {
+        board.tiles[i] = (i + 1) % PUZZLE_LENGTH;
+    }
+    
+    return board;
+}
+
+//Holds the ideal state of the puzzle, the goal a SearchContext starts with
+constexpr Board solvedBoard = makeSolvedPuzzle();
+const int* const solvedPuzzle = solvedBoard.tiles;
+
+//Holds every search the benchmark suite knows how to run
+SolverEntry solverTable[MEMORY_BOUNDED + 1] =
+{
+    {"bfs", runBreadthFirstSearch, BREADTH_FIRST},
+    {"dfs", runDepthFirstSearch, DEPTH_FIRST},
+    {"misplaced", runMisplacedTilesSearch, MISPLACED_TILES},
+    {"manhattan", runManhattenDistanceSearch, MANHATTAN_DISTANCE},
+    {"anytime", runAnytimeSearch, ANYTIME_WEIGHTED},
+    {"beam", runBeamSearch, BEAM},
+    {"sma", runMemoryBoundedSearch, MEMORY_BOUNDED},
+};
+
+//Holds the searches that have already been solved
+SolutionCache solutionCache;
+
+//Holds the searches a portfolio races when the caller has no list of its own. The greedy
+//search is quick on easy puzzles, breadth first on shallow ones and A* on the rest.
+const vector<Algorithm> defaultPortfolio = {MISPLACED_TILES, MANHATTAN_DISTANCE, BREADTH_FIRST, BEAM};
+
+//Holds how each search has done in portfolio races
+PortfolioStats portfolioStats;
+
+//Holds the optimal number of moves for every solvable puzzle, indexed by canonicalRank. It
+//keeps a byte for every rank, so on a square board the bytes of the larger rank of each
+//mirrored pair are never used.
+vector<unsigned char> depthTable;
+
+//Holds the canonical ranks of the puzzles at each optimal depth
+vector<vector<uint32_t>> depthBuckets;
+
+//---------------------------------------------------------------------------------------
+//makeBoard - Copies a puzzle array into a Board for solve()
+//---------------------------------------------------------------------------------------
+Board makeBoard(const int puzzleArray[])
+{
+    Board board;
+    memcpy(board.tiles, puzzleArray, sizeof board.tiles);
+    
+    return board;
+}
+
+//---------------------------------------------------------------------------------------
+//solve - Solves a puzzle toward the standard goal with a context of its own, so any number
+//        of threads can call it at once
+//---------------------------------------------------------------------------------------
+SolveResult solve(const Board& board, Algorithm algorithm, const Limits& limits)
+{
+    SearchContext context;
+    
+    return solve(board, algorithm, limits, context);
+}
+
+//---------------------------------------------------------------------------------------
+//solve - Solves a puzzle with the chosen search and hands back the path and statistics.
+//        The four original searches go through the solution cache. The anytime, beam and
+//        memory bounded searches run with the matching limit and are not cached. A search
+//        stopped by the limits hands back no path, its statistics and the reason it stopped.
+//        The search runs in the given context and toward its goal.
+//---------------------------------------------------------------------------------------
+SolveResult solve(const Board& board, Algorithm algorithm, const Limits& limits, SearchContext& context)
+{
+    //Holds what is handed back to the caller
+    SolveResult solveResult;
+    
+    //The searches work on a plain array they are free to read
+    int puzzleArray[PUZZLE_LENGTH];
+    memcpy(puzzleArray, board.tiles, sizeof puzzleArray);
+    
+    //Running the search
+    SearchResult result;
+    switch(algorithm)
+    {
+        case ANYTIME_WEIGHTED:
+            result = runAnytimeSearch(puzzleArray, limits, context, [&](const AnytimeStage& stage)
+            {
+                solveResult.anytimeStages.push_back(stage);
+            });
+            break;
+        case BEAM:
+            result = runBeamSearch(puzzleArray, limits, context);
+            break;
+        case MEMORY_BOUNDED:
+            result = runMemoryBoundedSearch(puzzleArray, limits, context);
+            break;
+        default:
+            result = cachedSearch(puzzleArray, algorithm, limits, context);
+            break;
+    }
+    
+    //Copying the path out from start to goal, so the states can be released
+    for(State* state = result.goalState; state != NULL; state = state->parent)
+    {
+        solveResult.path.push_back(*state);
+        solveResult.path.back().parent = NULL;
+    }
+    reverse(solveResult.path.begin(), solveResult.path.end());
+    
+    solveResult.solved = result.goalState != NULL;
+    solveResult.totalNodeCount = result.totalNodeCount;
+    solveResult.elapsedTime = result.elapsedTime;
+    solveResult.memoryBytes = result.memoryBytes;
+    solveResult.fromCache = result.fromCache;
+    solveResult.forgottenNodes = result.forgottenNodes;
+    solveResult.stopReason = result.stopReason;
+    solveResult.algorithm = algorithm;
+    
+    //Releasing the states created by the search
+    releaseSearchResult(result);
+    
+    return solveResult;
+}
+
+//---------------------------------------------------------------------------------------
+//solve - Solves a puzzle toward any goal with a context of its own
+//---------------------------------------------------------------------------------------
+SolveResult solve(const Board& board, const Board& goal, Algorithm algorithm, const Limits& limits)
+{
+    SearchContext context;
+    
+    return solve(board, goal, algorithm, limits, context);
+}
+
+//---------------------------------------------------------------------------------------
+//buildGoalFrame - Fills in the frame for one symmetry of the board. Bit 4 of the symmetry
+//                 turns the board on its main diagonal, which only a square board has, bit 2
+//                 flips it top to bottom and bit 1 flips it left to right.
+//---------------------------------------------------------------------------------------
+void buildGoalFrame(const int goal[], int symmetry, GoalFrame& frame)
+{
+    for(int i = 0; i < PUZZLE_LENGTH; i++)
+    {
+        int row = i / PUZZLE_WIDTH;
+        int column = i % PUZZLE_WIDTH;
+        
+        if(symmetry & 4)
+        {
+            swap(row, column);
+        }
+        if(symmetry & 2)
+        {
+            row = PUZZLE_HEIGHT - 1 - row;
+        }
+        if(symmetry & 1)
+        {
+            column = PUZZLE_WIDTH - 1 - column;
+        }
+        
+        frame.position[i] = row * PUZZLE_WIDTH + column;
+    }
+    
+    //Naming each tile after the standard tile on the square it lands on
+    for(int i = 0; i < PUZZLE_LENGTH; i++)
+    {
+        frame.tileName[goal[i]] = solvedPuzzle[frame.position[i]];
+        frame.originalTile[solvedPuzzle[frame.position[i]]] = goal[i];
+    }
+}
+
+//---------------------------------------------------------------------------------------
+//findGoalFrame - Finds the symmetry and tile names that carry a goal onto the standard goal.
+//                Returns false if no symmetry moves the goal's empty space to the standard
+//                goal's, which happens when it is on an edge or in the middle.
+//---------------------------------------------------------------------------------------
+bool findGoalFrame(const int goal[], GoalFrame& frame)
+{
+    int goalSpace = 0;
+    int standardSpace = 0;
+    for(int i = 0; i < PUZZLE_LENGTH; i++)
+    {
+        goalSpace = goal[i] == 0 ? i : goalSpace;
+        standardSpace = solvedPuzzle[i] == 0 ? i : standardSpace;
+    }
+    
+    //Trying each symmetry, the unchanged board first. Only a square board can be turned on
+    //its diagonal, other shapes can only be flipped.
+    int symmetryCount = PUZZLE_WIDTH == PUZZLE_HEIGHT ? 8 : 4;
+    for(int symmetry = 0; symmetry < symmetryCount; symmetry++)
+    {
+        buildGoalFrame(goal, symmetry, frame);
+        
+        if(frame.position[goalSpace] == standardSpace)
+        {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+//---------------------------------------------------------------------------------------
+//reflectPuzzle - Turns a puzzle on the board's main diagonal and renames its tiles so the
+//                standard goal turns into itself. A puzzle and its mirror are the same number
+//                of moves from the standard goal, and their moves mirror each other, so a
+//                search only has to look at one of the two. Square boards only.
+//---------------------------------------------------------------------------------------
+void reflectPuzzle(const int puzzleArray[], int reflected[])
+{
+    //Built once, the standard goal seen through the turn onto the diagonal
+    static const GoalFrame diagonalFrame = []
+    {
+        GoalFrame frame;
+        buildGoalFrame(solvedPuzzle, 4, frame);
+        return frame;
+    }();
+    
+    for(int i = 0; i < PUZZLE_LENGTH; i++)
+    {
+        reflected[diagonalFrame.position[i]] = diagonalFrame.tileName[puzzleArray[i]];
+    }
+}
+
+//---------------------------------------------------------------------------------------
+//solve - Solves a puzzle toward any goal. When the goal can be carried onto the standard
+//        goal, the board is carried the same way and solved toward the standard goal, so the
+//        cache and every table are used as they are and the goal costs nothing extra. The
+//        path is carried back afterwards. A goal with its empty space on an edge or in the
+//        middle is solved toward directly, without the cache.
+//---------------------------------------------------------------------------------------
+SolveResult solve(const Board& board, const Board& goal, Algorithm algorithm, const Limits& limits, SearchContext& context)
+{
+    GoalFrame frame;
+    
+    if(memcmp(goal.tiles, solvedPuzzle, sizeof goal.tiles) == 0 || !findGoalFrame(goal.tiles, frame))
+    {
+        context.setGoal(goal.tiles);
+        return solve(board, algorithm, limits, context);
+    }
+    
+    //Carrying the board into the standard frame
+    Board framedBoard;
+    for(int i = 0; i < PUZZLE_LENGTH; i++)
+    {
+        framedBoard.tiles[frame.position[i]] = frame.tileName[board.tiles[i]];
+    }
+    
+    context.setGoal(solvedPuzzle);
+    SolveResult result = solve(framedBoard, algorithm, limits, context);
+    
+    //Carrying each state on the path back. The heuristic values are distances, which the
+    //symmetry and the new names do not change.
+    for(State& state : result.path)
+    {
+        int framedState[PUZZLE_LENGTH];
+        memcpy(framedState, state.currentState, sizeof framedState);
+        
+        for(int i = 0; i < PUZZLE_LENGTH; i++)
+        {
+            state.currentState[i] = frame.originalTile[framedState[frame.position[i]]];
+        }
+        state.spaceLocation = findEmptySpace(state.currentState);
+    }
+    
+    return result;
+}
+
+//----------------------------------------------------------------------
+//newState - Functional to allocate a new node
+//----------------------------------------------------------------------
+State* newState(int puzzleArray[], int space, int moveCount, int newSpace, State* parent)
+{
+    //Creating a new state
+    State* state = new State;
+    
+    //Setting the pointer for the path to the root
+    state->parent = parent;
+    
+    //Copy the state from the parent state to the new state
+    memcpy(state->currentState, puzzleArray, sizeof state->currentState);
+    
+    //Moving the empty space
+    swap(state->currentState[space], state->currentState[newSpace]);
+    
+    //Setting the number of misplaced tiles or manhattenDistance
+    state->misplacedTiles = INT_MAX;
+    
+    //Set the number of moves
+    state->moveCount = moveCount;
+    
+    //Updating the location of the new space location
+    state->spaceLocation = newSpace;
+    
+    //Not waiting in any frontier yet
+    state->frontierSlot = -1;
+    
+    return state;
+}
+
+//----------------------------------------------------------------------
+//expandState - Creates the children of a state and returns how many were made. The move
+//              that would undo the parent's own move is never made, and neither is a child
+//              whose puzzle is already in the context's seen list. With markSeen the
+//              children are added to the list as they are made.
+//----------------------------------------------------------------------
+int expandState(State* parent, State* children[], bool markSeen, SearchResult& result, SearchContext& context)
+{
+    int space = parent->spaceLocation;
+    
+    //The space location before the parent's move, moving back there would undo it
+    int lastSpace = parent->parent != NULL ? parent->parent->spaceLocation : -1;
+    
+    //Holds the locations the space can move to
+    int moves[4];
+    int moveTotal = legalMoves(space, lastSpace, moves);
+    
+    int childCount = 0;
+    for(int m = 0; m < moveTotal; m++)
+    {
+        //Checking the child's puzzle before allocating a state for it
+        int childPuzzle[PUZZLE_LENGTH];
+        memcpy(childPuzzle, parent->currentState, sizeof childPuzzle);
+        swap(childPuzzle[space], childPuzzle[moves[m]]);
+        
+        PackedPuzzle packedPuzzle = canonicalPuzzle(childPuzzle, context);
+        if(listSearch(packedPuzzle, context))
+        {
+            continue;
+        }
+        if(markSeen)
+        {
+            context.seenPuzzles.insert(packedPuzzle);
+        }
+        
+        //Creating the new state
+        State* child = newState(parent->currentState, space, parent->moveCount + 1, moves[m], parent);
+        result.createdStates.push_back(child);
+        result.totalNodeCount++;
+        
+        children[childCount++] = child;
+    }
+    
+    return childCount;
+}
+
+//---------------------------------------------------------------------------------------
+//SearchContext::SearchContext - Makes a context that solves toward the standard goal
+//---------------------------------------------------------------------------------------
+SearchContext::SearchContext()
+{
+    setGoal(solvedPuzzle);
+}
+
+//---------------------------------------------------------------------------------------
+//SearchContext::SearchContext - Makes a context that solves toward the given goal
+//---------------------------------------------------------------------------------------
+SearchContext::SearchContext(const int goalArray[])
+{
+    setGoal(goalArray);
+}
+
+//---------------------------------------------------------------------------------------
+//SearchContext::setGoal - Changes the puzzle the searches in this context solve toward
+//---------------------------------------------------------------------------------------
+void SearchContext::setGoal(const int goalArray[])
+{
+    //The heuristic values were worked out toward the old goal
+    if(memcmp(goal, goalArray, sizeof goal) != 0)
+    {
+        manhattanCache.clear();
+        misplacedCache.clear();
+    }
+    
+    memcpy(goal, goalArray, sizeof goal);
+    packedGoal = arrayToIntConverter(goal);
+    
+    //The mirror of a puzzle is as far from the goal as the puzzle only when the goal is its own
+    //mirror, which the standard goal on a square board is
+    mirrorSeen = PUZZLE_WIDTH == PUZZLE_HEIGHT && memcmp(goal, solvedPuzzle, sizeof goal) == 0;
+}
+
+//---------------------------------------------------------------------------------------
+//SearchContext::reset - Empties the seen list for the next search. clear() keeps the bucket
+//                       array, so a reused context does not have to grow it again.
+//---------------------------------------------------------------------------------------
+void SearchContext::reset()
+{
+    seenPuzzles.clear();
+}
+
+//---------------------------------------------------------------------------------------
+//HeuristicCache::clear - Empties every slot. The hit and miss counts are kept.
+//---------------------------------------------------------------------------------------
+void HeuristicCache::clear()
+{
+    fill(entries.begin(), entries.end(), Entry{0, 0});
+}
+
+//---------------------------------------------------------------------------------------
+//HeuristicCache::hitRate - Returns the share of lookups answered from a slot, 0 before any
+//---------------------------------------------------------------------------------------
+double HeuristicCache::hitRate() const
+{
+    uint64_t lookups = hits + misses;
+    return lookups > 0 ? (double) hits / lookups : 0.0;
+}
+
+//---------------------------------------------------------------------------------------
+//cachedHeuristic - Returns Evaluate's value for the puzzle, from the cache if the puzzle is in
+//                  its slot, otherwise working it out and putting it in the slot
+//---------------------------------------------------------------------------------------
+template <int (*Evaluate)(int[], const SearchContext&)>
+int cachedHeuristic(int puzzleArray[], HeuristicCache& cache, const SearchContext& context)
+{
+    if(cache.entries.empty())
+    {
+        cache.entries.assign(HEURISTIC_CACHE_SIZE, HeuristicCache::Entry{0, 0});
+    }
+    
+    PackedPuzzle packedPuzzle = arrayToIntConverter(puzzleArray);
+    uint64_t hash = hashPuzzle(packedPuzzle);
+    HeuristicCache::Entry& entry = cache.entries[(size_t) (hash >> 32) & (HEURISTIC_CACHE_SIZE - 1)];
+    
+    if(entry.puzzle == packedPuzzle)
+    {
+        cache.hits++;
+        return entry.value;
+    }
+    
+    cache.misses++;
+    entry.puzzle = packedPuzzle;
+    entry.value = Evaluate(puzzleArray, context);
+    return entry.value;
+}
+
+//---------------------------------------------------------------------------------------
+//cachedManhattanDistance - getManhattanDistance through the context's cache
+//---------------------------------------------------------------------------------------
+int cachedManhattanDistance(int puzzleArray[], const SearchContext& context)
+{
+    return cachedHeuristic<getManhattanDistance>(puzzleArray, context.manhattanCache, context);
+}
+
+//---------------------------------------------------------------------------------------
+//cachedMisplacedTiles - countMisplacedTiles through the context's cache
+//---------------------------------------------------------------------------------------
+int cachedMisplacedTiles(int puzzleArray[], const SearchContext& context)
+{
+    return cachedHeuristic<countMisplacedTiles>(puzzleArray, context.misplacedCache, context);
+}
+
+//---------------------------------------------------------------------------------------
+//releaseSearchResult - Deletes every state a search created
+//---------------------------------------------------------------------------------------
+void releaseSearchResult(SearchResult& result)
+{
+    for(size_t i = 0; i < result.createdStates.size(); i++)
+    {
+        delete result.createdStates[i];
+    }
+    
+    result.createdStates.clear();
+    result.goalState = NULL;
+}
+
+//---------------------------------------------------------------------------------------
+//cachedSearch - Checks the solution cache before running a search. A new result is stored in
+//               the cache so the next request for the same puzzle and search is a lookup.
+//               A search stopped by its limits is not stored, since it did not finish. The
+//               cache only holds solutions to the standard goal, so a context with another
+//               goal always runs the search.
+//---------------------------------------------------------------------------------------
+SearchResult cachedSearch(int puzzleArray[], Algorithm algorithm, const Limits& limits, SearchContext& context)
+{
+    SearchResult result;
+    bool standardGoal = memcmp(context.goal, solvedPuzzle, sizeof context.goal) == 0;
+    
+    if(standardGoal && solutionCache.lookup(puzzleArray, algorithm, result))
+    {
+        return result;
+    }
+    
+    result = solverTable[algorithm].run(puzzleArray, limits, context);
+    if(standardGoal && result.stopReason == NOT_STOPPED)
+    {
+        solutionCache.store(puzzleArray, algorithm, result);
+    }
+    
+    return result;
+}
+
+//---------------------------------------------------------------------------------------
+//solvePortfolio - Races the given searches on the same board, one thread each, and hands
+//                 back the first result good enough for the quality asked for. The other
+//                 searches are cancelled. With OPTIMAL_SOLUTION only the searches that find
+//                 the shortest solution are run, and A* is run if none of them are.
+//---------------------------------------------------------------------------------------
+SolveResult solvePortfolio(const Board& board, const vector<Algorithm>& algorithms, SolutionQuality quality, const Limits& limits)
+{
+    //Picking the searches that can give a good enough answer
+    vector<Algorithm> racers;
+    for(Algorithm algorithm : algorithms)
+    {
+        if(quality == ANY_SOLUTION || findsShortestSolution(algorithm))
+        {
+            racers.push_back(algorithm);
+        }
+    }
+    if(racers.empty())
+    {
+        racers.push_back(MANHATTAN_DISTANCE);
+    }
+    
+    //Every racer stops on the portfolio's token. The progress is left out, as the racers
+    //would all write over each other's counters.
+    CancellationToken raceOver;
+    Limits racerLimits = limits;
+    racerLimits.cancellation = &raceOver;
+    racerLimits.progress = NULL;
+    
+    //Holds the winning result, or the last one to finish if nothing wins
+    SolveResult outcome;
+    bool won = false;
+    size_t finished = 0;
+    mutex raceMutex;
+    condition_variable raceFinished;
+    
+    vector<thread> threads;
+    for(Algorithm algorithm : racers)
+    {
+        portfolioStats.races[algorithm].fetch_add(1, memory_order_relaxed);
+        
+        threads.emplace_back([&, algorithm]
+        {
+            SolveResult result = solve(board, algorithm, racerLimits);
+            
+            //A solution wins. So does one of the first four searches finishing without one, as
+            //they try every puzzle that can be reached and so prove there is no solution.
+            bool answered = result.solved || (result.stopReason == NOT_STOPPED && algorithm <= MANHATTAN_DISTANCE);
+            
+            lock_guard<mutex> lock(raceMutex);
+            if(!won)
+            {
+                won = answered;
+                outcome = move(result);
+            }
+            finished++;
+            raceFinished.notify_one();
+        });
+    }
+    
+    //Waiting for a winner, passing the caller's cancellation on to the racers
+    {
+        unique_lock<mutex> lock(raceMutex);
+        while(!raceFinished.wait_for(lock, chrono::milliseconds(10), [&] { return won || finished == racers.size(); }))
+        {
+            if(limits.cancellation != NULL && limits.cancellation->isCancelled())
+            {
+                raceOver.cancel();
+            }
+        }
+    }
+    raceOver.cancel();
+    
+    for(thread& racer : threads)
+    {
+        racer.join();
+    }
+    
+    if(won)
+    {
+        portfolioStats.wins[outcome.algorithm].fetch_add(1, memory_order_relaxed);
+        portfolioStats.winMicroseconds[outcome.algorithm].fetch_add((uint64_t) (outcome.elapsedTime * 1e6), memory_order_relaxed);
+    }
+    
+    return outcome;
+}
+
+//---------------------------------------------------------------------------------------
+//findsShortestSolution - Returns true if a search always hands back the shortest solution
+//---------------------------------------------------------------------------------------
+bool findsShortestSolution(Algorithm algorithm)
+{
+    return algorithm == BREADTH_FIRST || algorithm == MANHATTAN_DISTANCE;
+}
+
+//---------------------------------------------------------------------------------------
+//PortfolioStats::clear - Resets the race and win counters
+//---------------------------------------------------------------------------------------
+void PortfolioStats::clear()
+{
+    for(int a = 0; a <= MEMORY_BOUNDED; a++)
+    {
+        races[a] = 0;
+        wins[a] = 0;
+        winMicroseconds[a] = 0;
+    }
+}
+
+//---------------------------------------------------------------------------------------
+//ConcurrentSeenSet::ConcurrentSeenSet - Makes a table with at least twice as many slots as
+//                                       the node budget, so it stays at most half full
+//---------------------------------------------------------------------------------------
+ConcurrentSeenSet::ConcurrentSeenSet(size_t nodeBudget) : slots(0), mask(0)
+{
+    size_t slotCount = 16;
+    while(slotCount < 2 * nodeBudget)
+    {
+        slotCount *= 2;
+    }
+    
+    //Every slot starts empty, as the atomics are value initialized
+    slots = vector<atomic<PackedPuzzle>>(slotCount);
+    mask = slotCount - 1;
+}
+
+//---------------------------------------------------------------------------------------
+//ConcurrentSeenSet::insert - Adds a packed puzzle. Returns true if this call added it, false
+//                            if it was already there. A full table also returns false, so a
+//                            caller that goes past its node budget treats the puzzle as seen.
+//---------------------------------------------------------------------------------------
+bool ConcurrentSeenSet::insert(PackedPuzzle packedPuzzle)
+{
+    uint64_t hash = hashPuzzle(packedPuzzle);
+    size_t slot = (size_t) (hash >> 32) & mask;
+    
+    for(size_t probe = 0; probe <= mask; probe++)
+    {
+        //The puzzle is the only thing stored, so relaxed ordering is enough
+        PackedPuzzle current = slots[slot].load(memory_order_relaxed);
+        
+        if(current == 0)
+        {
+            //Claiming the empty slot, unless another thread claims it first
+            if(slots[slot].compare_exchange_strong(current, packedPuzzle, memory_order_relaxed))
+            {
+                count.fetch_add(1, memory_order_relaxed);
+                return true;
+            }
+        }
+        
+        if(current == packedPuzzle)
+        {
+            return false;
+        }
+        
+        slot = (slot + 1) & mask;
+    }
+    
+    return false;
+}
+
+//---------------------------------------------------------------------------------------
+//ConcurrentSeenSet::contains - Returns true if the packed puzzle has been added
+//---------------------------------------------------------------------------------------
+bool ConcurrentSeenSet::contains(PackedPuzzle packedPuzzle) const
+{
+    uint64_t hash = hashPuzzle(packedPuzzle);
+    size_t slot = (size_t) (hash >> 32) & mask;
+    
+    for(size_t probe = 0; probe <= mask; probe++)
+    {
+        PackedPuzzle current = slots[slot].load(memory_order_relaxed);
+        
+        if(current == packedPuzzle)
+        {
+            return true;
+        }
+        if(current == 0)
+        {
+            return false;
+        }
+        
+        slot = (slot + 1) & mask;
+    }
+    
+    return false;
+}
+
+//---------------------------------------------------------------------------------------
+//ConcurrentSeenSet::clear - Empties the table for the next search. Not safe to call while
+//                           other threads are still adding to it.
+//---------------------------------------------------------------------------------------
+void ConcurrentSeenSet::clear()
+{
+    for(atomic<PackedPuzzle>& slot : slots)
+    {
+        slot.store(0, memory_order_relaxed);
+    }
+    count = 0;
+}
+
+//---------------------------------------------------------------------------------------
+//stopReasonName - Returns a few words saying why a search stopped
+//---------------------------------------------------------------------------------------
+const char* stopReasonName(StopReason reason)
+{
+    switch(reason)
+    {
+        case NODE_LIMIT_REACHED:
+            return "node limit reached";
+        case MEMORY_LIMIT_REACHED:
+            return "memory limit reached";
+        case DEADLINE_REACHED:
+            return "deadline reached";
+        case SEARCH_CANCELLED:
+            return "cancelled";
+        default:
+            return "finished";
+    }
+}
+
+//---------------------------------------------------------------------------------------
+//SolutionCache::lookup - Rebuilds the result of a search that has been solved before. Returns
+//                        false if the puzzle and search are not in the cache.
+//---------------------------------------------------------------------------------------
+bool SolutionCache::lookup(int puzzleArray[], Algorithm algorithm, SearchResult& result)
+{
+    uint64_t key = (uint64_t) arrayToIntConverter(puzzleArray) * (MEMORY_BOUNDED + 1) + algorithm;
+    
+    lock_guard<mutex> lock(cacheMutex);
+    
+    auto found = lookupTable.find(key);
+    if(found == lookupTable.end())
+    {
+        misses++;
+        return false;
+    }
+    
+    hits++;
+    
+    //Moving the entry to the front as the most recently used
+    entries.splice(entries.begin(), entries, found->second);
+    const Entry& entry = *found->second;
+    
+    //Copying the path into new states linked back to the start
+    pathToStates(entry.path, result);
+    result.totalNodeCount = entry.totalNodeCount;
+    result.elapsedTime = entry.elapsedTime;
+    result.memoryBytes = entry.memoryBytes;
+    result.fromCache = true;
+    
+    return true;
+}
+
+//---------------------------------------------------------------------------------------
+//SolutionCache::store - Saves the result of a search, dropping the least recently used entry
+//                       once the cache is full.
+//---------------------------------------------------------------------------------------
+void SolutionCache::store(int puzzleArray[], Algorithm algorithm, const SearchResult& result)
+{
+    Entry entry;
+    entry.key = (uint64_t) arrayToIntConverter(puzzleArray) * (MEMORY_BOUNDED + 1) + algorithm;
+    entry.totalNodeCount = result.totalNodeCount;
+    entry.elapsedTime = result.elapsedTime;
+    entry.memoryBytes = result.memoryBytes;
+    
+    //Copying the path from the goal back to the start, then putting it in order
+    for(State* state = result.goalState; state != NULL; state = state->parent)
+    {
+        entry.path.push_back(*state);
+        entry.path.back().parent = NULL;
+    }
+    reverse(entry.path.begin(), entry.path.end());
+    
+    lock_guard<mutex> lock(cacheMutex);
+    
+    //Replacing an older entry for the same key
+    auto found = lookupTable.find(entry.key);
+    if(found != lookupTable.end())
+    {
+        entries.erase(found->second);
+        lookupTable.erase(found);
+    }
+    
+    //Dropping the least recently used entry when full
+    if(capacity == 0)
+    {
+        return;
+    }
+    if(entries.size() >= capacity)
+    {
+        lookupTable.erase(entries.back().key);
+        entries.pop_back();
+    }
+    
+    entries.push_front(move(entry));
+    lookupTable[entries.front().key] = entries.begin();
+}
+
+//---------------------------------------------------------------------------------------
+//SolutionCache::clear - Empties the cache and resets the hit and miss counters
+//---------------------------------------------------------------------------------------
+void SolutionCache::clear()
+{
+    lock_guard<mutex> lock(cacheMutex);
+    
+    entries.clear();
+    lookupTable.clear();
+    hits = 0;
+    misses = 0;
+}
+
+//---------------------------------------------------------------------------------------
+//genericSearch - The search loop shared by the four original searches, put together from a
+//                frontier, heuristic and duplicate policy. Each combination compiles to its
+//                own loop, and the search hands its result back without any user interaction.
+//---------------------------------------------------------------------------------------
+template <class Frontier, class Heuristic, class DuplicatePolicy>
+SearchResult genericSearch(int puzzleArray[], const Limits& limits, SearchContext& context)
+{
+    //Starting timer
+    auto start = chrono::steady_clock::now();
+    
+    //Holds the result of the search
+    SearchResult result;
+    
+    //Clearing the seen list left by the last search in this context
+    context.reset();
+    
+    //Creating the frontier
+    Frontier frontier;
+    SearchLimiter limiter(limits);
+    
+    //Variable to hold the return value from the function that finds the empty space
+    int startingEmptySpaceLocation = findEmptySpace(puzzleArray);
+    
+    //Creating a newNode with the necessary information
+    State* startingState = newState(puzzleArray, startingEmptySpaceLocation, 0, startingEmptySpaceLocation, NULL);
+    result.createdStates.push_back(startingState);
+    result.totalNodeCount++;
+    
+    if(DuplicatePolicy::markOnGeneration)
+    {
+        context.seenPuzzles.insert(canonicalPuzzle(puzzleArray, context));
+    }
+    
+    //Checking if the puzzle was handed over already solved
+    if(DuplicatePolicy::markOnGeneration && puzzleSolved(arrayToIntConverter(puzzleArray), context))
+    {
+        result.goalState = startingState;
+    }
+    else
+    {
+        //Pushing the startingState struct onto the frontier
+        frontier.push(startingState, Heuristic::score(startingState, context));
+    }
+    
+    //Holds the depth and score of the last puzzle taken off the frontier, for the progress
+    int currentDepth = 0;
+    int currentBound = Heuristic::stored(startingState);
+    
+    //While the frontier is not empty and the goal has not been found, run this
+    while(!frontier.empty() && result.goalState == NULL)
+    {
+        //Stopping early once a limit is reached
+        if(limiter.shouldStop(result, [&] { return result.createdStates.size() * sizeof(State) + context.seenPuzzles.size() * (sizeof(int) + 2 * sizeof(void*)); }, frontier.size(), currentDepth, currentBound))
+        {
+            break;
+        }
+        
+        //Setting the working puzzle to the next puzzle on the frontier
+        State* tempPuzzle = frontier.pop();
+        currentDepth = tempPuzzle->moveCount;
+        currentBound = Heuristic::stored(tempPuzzle);
+        
+        if(!DuplicatePolicy::markOnGeneration)
+        {
+            //Skipping a puzzle that has already been expanded, or whose mirror has
+            PackedPuzzle tempPuzzleState = canonicalPuzzle(tempPuzzle->currentState, context);
+            if(!context.seenPuzzles.insert(tempPuzzleState).second)
+            {
+                continue;
+            }
+            
+            //If all the tiles are in the correct location, we have reached the solved puzzle.
+            //The goal is its own mirror, so its seen list entry is the goal packed as it is.
+            if(puzzleSolved(tempPuzzleState, context))
+            {
+                result.goalState = tempPuzzle;
+                break;
+            }
+        }
+        
+        //Creating the children that have not been seen and adding them to the frontier
+        State* children[4];
+        int childCount = expandState(tempPuzzle, children, DuplicatePolicy::markOnGeneration, result, context);
+        
+        for(int c = 0; c < childCount; c++)
+        {
+            //Checking if the child is the ideal state (SOLVED)
+            if(DuplicatePolicy::markOnGeneration && puzzleSolved(arrayToIntConverter(children[c]->currentState), context))
+            {
+                result.goalState = children[c];
+                break;
+            }
+            
+            frontier.push(children[c], Heuristic::score(children[c], context));
+        }
+    }
+    
+    //Estimating the memory held by the states and the seen list
+    result.memoryBytes = result.createdStates.size() * sizeof(State) + context.seenPuzzles.size() * (sizeof(int) + 2 * sizeof(void*));
+    
+    //Clearing the list, keeping its buckets for the next search in this context
+    context.reset();
+    
+    //Stopping timer
+    chrono::duration<double> elapsedTime = chrono::steady_clock::now() - start;
+    result.elapsedTime = elapsedTime.count();
+    
+    return result;
+}
+
+//---------------------------------------------------------------------------------------
+//MisplacedTilesHeuristic::score - Stores and returns the number of misplaced tiles
+//---------------------------------------------------------------------------------------
+int MisplacedTilesHeuristic::score(State* state, const SearchContext& context)
+{
+    state->misplacedTiles = cachedMisplacedTiles(state->currentState, context);
+    return state->misplacedTiles;
+}
+
+//---------------------------------------------------------------------------------------
+//ManhattanHeuristic::score - Stores and returns the moves so far plus the manhatten distance
+//---------------------------------------------------------------------------------------
+int ManhattanHeuristic::score(State* state, const SearchContext& context)
+{
+    state->manhattanDistance = cachedManhattanDistance(state->currentState, context) + state->moveCount;
+    return state->manhattanDistance;
+}
+
+//---------------------------------------------------------------------------------------
+//runBreadthFirstSearch - Breadth First Search algorithim that hands its result back to the
+//                        caller without any user interaction. Puzzles are checked for the
+//                        goal when they are created, which saves searching a whole layer.
+//---------------------------------------------------------------------------------------
+SearchResult runBreadthFirstSearch(int puzzleArray[], const Limits& limits, SearchContext& context)
+{
+    return genericSearch<FifoFrontier, NoHeuristic, SeenOnGeneration>(puzzleArray, limits, context);
+}
+
+//---------------------------------------------------------------------------------------
+//runDepthFirstSearch - Depth First Search algorithim that hands its result back to the
+//                      caller without any user interaction.
+//---------------------------------------------------------------------------------------
+SearchResult runDepthFirstSearch(int puzzleArray[], const Limits& limits, SearchContext& context)
+{
+    return genericSearch<LifoFrontier, NoHeuristic, SeenOnGeneration>(puzzleArray, limits, context);
+}
+
+//---------------------------------------------------------------------------------------
+//runMisplacedTilesSearch - A* search using the misplaced tiles method that hands its result
+//                          back to the caller without any user interaction.
+//---------------------------------------------------------------------------------------
+SearchResult runMisplacedTilesSearch(int puzzleArray[], const Limits& limits, SearchContext& context)
+{
+    return genericSearch<HeapFrontier<comp>, MisplacedTilesHeuristic, ClosedOnExpansion>(puzzleArray, limits, context);
+}
+
+//---------------------------------------------------------------------------------------
+//runManhattenDistanceSearch - A* search using the "Manhatten Distance" method that hands its
+//                             result back to the caller without any user interaction. Each board
+//                             waits in the open list once, with the best moves found to it so far.
+//---------------------------------------------------------------------------------------
+SearchResult runManhattenDistanceSearch(int puzzleArray[], const Limits& limits, SearchContext& context)
+{
+    return genericSearch<IndexedHeapFrontier<deeperMdcomp>, ManhattanHeuristic, ClosedOnExpansion>(puzzleArray, limits, context);
+}
+
+//---------------------------------------------------------------------------------------
+//runAnytimeSearch - Anytime weighted A* search that does not report its stages
+//---------------------------------------------------------------------------------------
+SearchResult runAnytimeSearch(int puzzleArray[], const Limits& limits, SearchContext& context)
+{
+    return runAnytimeSearch(puzzleArray, limits, context, [](const AnytimeStage&) {});
+}
+
+//---------------------------------------------------------------------------------------
+//runAnytimeSearch - Anytime Repairing A* (ARA*) using the manhatten distance. The first stage
+//                   orders the search by g + w * h with a large weight so a solution is found
+//                   quickly. Each stage after lowers the weight and carries on from the nodes the
+//                   last stage left behind, until the solution is proven optimal or the time
+//                   limit has passed. onStage is called with every solution found. Reaching one
+//                   of the other limits keeps the best solution found before it.
+//---------------------------------------------------------------------------------------
+SearchResult runAnytimeSearch(int puzzleArray[], const Limits& limits, SearchContext& context, const function<void(const AnytimeStage&)>& onStage)
+{
+    //Starting timer
+    auto start = chrono::steady_clock::now();
+    auto deadline = start + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(limits.timeLimit));
+    SearchLimiter limiter(limits);
+    
+    //Holds the result of the search
+    SearchResult result;
+    
+    //This is the struct that holds what the search knows about each puzzle it has reached
+    struct AnytimeNode
+    {
+        State* state;                   //Holds the puzzle, its move count (g) and its parent
+        int heuristic;                  //Holds the manhatten distance (h)
+        bool inOpen;                    //Holds true while waiting to be expanded this stage
+        bool closed;                    //Holds true once expanded this stage
+        bool inconsistent;              //Holds true if improved after being expanded this stage
+    };
+    
+    //This is the struct pushed on the open list. Entries left behind by an improvement are skipped.
+    struct OpenEntry
+    {
+        double priority;                //Holds g + w * h
+        int moveCount;                  //Holds g when the entry was pushed
+        AnytimeNode* node;
+        
+        bool operator>(const OpenEntry& rhs) const
+        {
+            //Breaking ties toward the deeper node
+            return priority > rhs.priority || (priority == rhs.priority && moveCount < rhs.moveCount);
+        }
+    };
+    
+    unordered_map<PackedPuzzle, AnytimeNode> nodes;
+    priority_queue<OpenEntry, vector<OpenEntry>, greater<OpenEntry>> openList;
+    
+    double weight = ANYTIME_START_WEIGHT;
+    int expandedNodes = 0;
+    bool outOfTime = false;
+    
+    //Creating the starting node
+    int startingEmptySpaceLocation = findEmptySpace(puzzleArray);
+    State* startingState = newState(puzzleArray, startingEmptySpaceLocation, 0, startingEmptySpaceLocation, NULL);
+    result.createdStates.push_back(startingState);
+    
+    AnytimeNode& startingNode = nodes[arrayToIntConverter(puzzleArray)];
+    startingNode = {startingState, cachedManhattanDistance(puzzleArray, context), true, false, false};
+    startingState->manhattanDistance = startingNode.heuristic;
+    openList.push({weight * startingNode.heuristic, 0, &startingNode});
+    
+    //Holds the goal node once it has been reached, which is the start if it is already solved
+    AnytimeNode* goalNode = startingNode.heuristic == 0 ? &startingNode : NULL;
+    
+    //Holds the best path found so far
+    vector<State> bestPath;
+    
+    while(true)
+    {
+        //Expanding nodes until nothing on the open list can beat the goal under this weight
+        while(!openList.empty() && !outOfTime)
+        {
+            OpenEntry entry = openList.top();
+            AnytimeNode* node = entry.node;
+            
+            //Skipping entries for nodes that were improved or already expanded
+            if(!node->inOpen || entry.moveCount != node->state->moveCount)
+            {
+                openList.pop();
+                continue;
+            }
+            
+            if(goalNode != NULL && goalNode->state->moveCount <= entry.priority)
+            {
+                break;
+            }
+            
+            openList.pop();
+            node->inOpen = false;
+            node->closed = true;
+            expandedNodes++;
+            
+            //Checking the clock every so often
+            if((expandedNodes & 255) == 0 && chrono::steady_clock::now() >= deadline)
+            {
+                outOfTime = true;
+            }
+            
+            //Stopping with the best solution so far once a limit is reached
+            result.totalNodeCount = (int) result.createdStates.size();
+            if(limiter.shouldStop(result, [&] { return result.createdStates.size() * sizeof(State) + nodes.size() * (sizeof(AnytimeNode) + sizeof(int) + 2 * sizeof(void*)); }, openList.size(), node->state->moveCount, node->state->moveCount + node->heuristic))
+            {
+                outOfTime = true;
+            }
+            
+            State* parent = node->state;
+            int space = parent->spaceLocation;
+            
+            //Holds the locations the space can move to
+            int moves[4];
+            int moveTotal = legalMoves(space, -1, moves);
+            
+            for(int m = 0; m < moveTotal; m++)
+            {
+                //Making the move to see which puzzle it reaches
+                swap(parent->currentState[space], parent->currentState[moves[m]]);
+                PackedPuzzle childKey = arrayToIntConverter(parent->currentState);
+                swap(parent->currentState[space], parent->currentState[moves[m]]);
+                
+                auto found = nodes.find(childKey);
+                AnytimeNode* child;
+                
+                if(found == nodes.end())
+                {
+                    //A new puzzle, creating its state
+                    State* childState = newState(parent->currentState, space, parent->moveCount + 1, moves[m], parent);
+                    result.createdStates.push_back(childState);
+                    
+                    child = &nodes[childKey];
+                    *child = {childState, cachedManhattanDistance(childState->currentState, context), false, false, false};
+                    
+                    if(child->heuristic == 0)
+                    {
+                        goalNode = child;
+                    }
+                }
+                else if(found->second.state->moveCount > parent->moveCount + 1)
+                {
+                    //A shorter way to a puzzle seen before
+                    child = &found->second;
+                    child->state->moveCount = parent->moveCount + 1;
+                    child->state->parent = parent;
+                }
+                else
+                {
+                    continue;
+                }
+                
+                child->state->manhattanDistance = child->state->moveCount + child->heuristic;
+                
+                //Nodes already expanded this stage wait until the next stage
+                if(child->closed)
+                {
+                    child->inconsistent = true;
+                }
+                else
+                {
+                    child->inOpen = true;
+                    openList.push({child->state->moveCount + weight * child->heuristic, child->state->moveCount, child});
+                }
+            }
+        }
+        
+        //Out of time before the first solution
+        if(goalNode == NULL)
+        {
+            break;
+        }
+        
+        //Working out how far from optimal the solution can be. No node left to expand has
+        //g + h below the optimal length.
+        double lowestEstimate = goalNode->state->moveCount;
+        for(auto& pair : nodes)
+        {
+            AnytimeNode& node = pair.second;
+            if(node.inOpen || node.inconsistent)
+            {
+                lowestEstimate = min(lowestEstimate, (double) (node.state->moveCount + node.heuristic));
+            }
+        }
+        
+        double bound = lowestEstimate > 0 ? min(weight, goalNode->state->moveCount / lowestEstimate) : 1.0;
+        bound = max(bound, 1.0);
+        
+        //Saving the current path, the goal's move count only goes down from stage to stage
+        bestPath.clear();
+        for(State* state = goalNode->state; state != NULL; state = state->parent)
+        {
+            bestPath.push_back(*state);
+        }
+        reverse(bestPath.begin(), bestPath.end());
+        
+        chrono::duration<double> elapsedTime = chrono::steady_clock::now() - start;
+        onStage({weight, bound, (int) bestPath.size() - 1, expandedNodes, elapsedTime.count()});
+        
+        //Stopping once the solution is proven optimal or the time is up
+        if(bound <= 1.0 || outOfTime || chrono::steady_clock::now() >= deadline)
+        {
+            break;
+        }
+        
+        //Lowering the weight and putting every waiting and improved node back on the open list
+        weight = max(1.0, weight - ANYTIME_WEIGHT_STEP);
+        
+        openList = priority_queue<OpenEntry, vector<OpenEntry>, greater<OpenEntry>>();
+        for(auto& pair : nodes)
+        {
+            AnytimeNode& node = pair.second;
+            
+            if(node.inOpen || node.inconsistent)
+            {
+                node.inOpen = true;
+                openList.push({node.state->moveCount + weight * node.heuristic, node.state->moveCount, &node});
+            }
+            
+            node.closed = false;
+            node.inconsistent = false;
+        }
+    }
+    
+    //Estimating the memory held by the states and the node table
+    result.memoryBytes = result.createdStates.size() * sizeof(State) + nodes.size() * (sizeof(AnytimeNode) + sizeof(int) + 2 * sizeof(void*));
+    result.totalNodeCount = (int) result.createdStates.size();
+    
+    //Setting the g + h of each step from its place on the path
+    for(size_t step = 0; step < bestPath.size(); step++)
+    {
+        bestPath[step].manhattanDistance = (int) step + getManhattanDistance(bestPath[step].currentState, context);
+    }
+    
+    //Handing back a clean copy of the best path, then releasing the search states
+    releaseSearchResult(result);
+    pathToStates(bestPath, result);
+    
+    //Stopping timer
+    chrono::duration<double> elapsedTime = chrono::steady_clock::now() - start;
+    result.elapsedTime = elapsedTime.count();
+    
+    return result;
+}
+
+//---------------------------------------------------------------------------------------
+//runBeamSearch - Breadth first search that only keeps the beamWidth children with the least
+//                manhatten distance in each layer. A child is dropped if another child in the
+//                layer has the same puzzle, or if it undoes its parent's move. At most
+//                beamWidth nodes are kept per layer, so memory and the time per layer stay
+//                bounded, at the cost of the solution not always being the shortest.
+//---------------------------------------------------------------------------------------
+SearchResult runBeamSearch(int puzzleArray[], const Limits& limits, SearchContext& context)
+{
+    //Starting timer
+    auto start = chrono::steady_clock::now();
+    int beamWidth = limits.beamWidth;
+    SearchLimiter limiter(limits);
+    
+    //Holds the result of the search
+    SearchResult result;
+    
+    //Creating the starting node
+    int startingEmptySpaceLocation = findEmptySpace(puzzleArray);
+    State* startingState = newState(puzzleArray, startingEmptySpaceLocation, 0, startingEmptySpaceLocation, NULL);
+    startingState->manhattanDistance = cachedManhattanDistance(puzzleArray, context);
+    result.createdStates.push_back(startingState);
+    result.totalNodeCount = 1;
+    
+    if(puzzleSolved(arrayToIntConverter(puzzleArray), context))
+    {
+        result.goalState = startingState;
+    }
+    
+    //Holds the nodes kept from the last layer and the children of this one
+    vector<State*> layer(1, startingState);
+    vector<State*> children;
+    children.reserve(4 * beamWidth);
+    
+    //Holds the puzzles already in the next layer
+    unordered_set<PackedPuzzle> layerPuzzles;
+    layerPuzzles.reserve(8 * beamWidth);
+    
+    size_t largestLayer = 1;
+    
+    for(int depth = 0; result.goalState == NULL && result.stopReason == NOT_STOPPED && !layer.empty() && depth < BEAM_MAX_DEPTH; depth++)
+    {
+        children.clear();
+        layerPuzzles.clear();
+        
+        for(State* parent : layer)
+        {
+            //Stopping early once a limit is reached
+            if(limiter.shouldStop(result, [&] { return (result.createdStates.size() + children.size()) * sizeof(State); }, layer.size() + children.size(), depth, -1))
+            {
+                break;
+            }
+            
+            int space = parent->spaceLocation;
+            
+            //The grandparent's space location, moving back there would undo the last move
+            int lastSpace = parent->parent != NULL ? parent->parent->spaceLocation : -1;
+            
+            //Holds the locations the space can move to
+            int moves[4];
+            int moveTotal = legalMoves(space, lastSpace, moves);
+            
+            for(int m = 0; m < moveTotal; m++)
+            {
+                //Making the move to see which puzzle it reaches
+                swap(parent->currentState[space], parent->currentState[moves[m]]);
+                PackedPuzzle childKey = arrayToIntConverter(parent->currentState);
+                swap(parent->currentState[space], parent->currentState[moves[m]]);
+                
+                //Skipping puzzles already in this layer
+                if(!layerPuzzles.insert(childKey).second)
+                {
+                    continue;
+                }
+                
+                State* child = newState(parent->currentState, space, parent->moveCount + 1, moves[m], parent);
+                child->manhattanDistance = cachedManhattanDistance(child->currentState, context);
+                children.push_back(child);
+                result.totalNodeCount++;
+                
+                //Stopping as soon as the goal is generated
+                if(child->manhattanDistance == 0)
+                {
+                    result.goalState = child;
+                    break;
+                }
+            }
+            
+            if(result.goalState != NULL)
+            {
+                break;
+            }
+        }
+        
+        //Moving the beamWidth best children to the front without sorting the whole layer
+        if((int) children.size() > beamWidth)
+        {
+            nth_element(children.begin(), children.begin() + beamWidth, children.end(), [](const State* lhs, const State* rhs)
+            {
+                return lhs->manhattanDistance < rhs->manhattanDistance;
+            });
+        }
+        
+        //Keeping the best children and deleting the rest, never dropping the goal
+        size_t keep = min(children.size(), (size_t) beamWidth);
+        layer.clear();
+        
+        for(size_t c = 0; c < children.size(); c++)
+        {
+            if(c < keep || children[c] == result.goalState)
+            {
+                layer.push_back(children[c]);
+                result.createdStates.push_back(children[c]);
+            }
+            else
+            {
+                delete children[c];
+            }
+        }
+        
+        largestLayer = max(largestLayer, children.size());
+    }
+    
+    //Setting the g + h of each state so the path printer shows the same value as A*
+    for(State* state : result.createdStates)
+    {
+        state->manhattanDistance += state->moveCount;
+    }
+    
+    //Estimating the memory held by the kept states and the largest layer
+    result.memoryBytes = result.createdStates.size() * sizeof(State) + largestLayer * (sizeof(State) + sizeof(State*) + sizeof(int) + 2 * sizeof(void*));
+    
+    //Stopping timer
+    chrono::duration<double> elapsedTime = chrono::steady_clock::now() - start;
+    result.elapsedTime = elapsedTime.count();
+    
+    return result;
+}
+
+//---------------------------------------------------------------------------------------
+//runMemoryBoundedSearch - Simplified Memory bounded A* (SMA*) using the manhatten distance.
+//                         It works like A* on a tree until nodeBudget nodes are held. Past
+//                         that it forgets the leaf with the highest f (the shallowest one on
+//                         ties) and keeps its f in the parent under the move that made it, so
+//                         the parent can regenerate the branch if it becomes the best choice again.
+//                         The solution is optimal whenever the optimal path fits in the budget.
+//                         The budget is the nodeLimit in limits.
+//---------------------------------------------------------------------------------------
+SearchResult runMemoryBoundedSearch(int puzzleArray[], const Limits& limits, SearchContext& context)
+{
+    //Starting timer
+    auto start = chrono::steady_clock::now();
+    int nodeBudget = limits.nodeLimit;
+    SearchLimiter limiter(limits);
+    
+    //Holds the result of the search
+    SearchResult result;
+    
+    //Holds the value used for a branch that cannot lead to a solution within the budget
+    const int unreachable = INT_MAX;
+    
+    //This is the struct that holds the tree the search keeps in memory
+    struct TreeNode
+    {
+        State* state;                   //Holds the puzzle, its move count (g) and its parent
+        int heuristic;                  //Holds the manhatten distance (h)
+        int f;                          //Holds the lowest f of the best leaf below this node
+        int forgottenF;                 //Holds the lowest f of the forgotten children
+        int forgottenChildF[4];         //Holds the f of each forgotten child by move, -1 if none
+        int openKey;                    //Holds the value this node is ordered by on the open list
+        long id;                        //Holds the order the node was created in
+        bool expanded;                  //Holds true once the children have been generated
+        bool inOpen;                    //Holds true while on the open list
+        TreeNode* parent;
+        vector<TreeNode*> children;     //Holds the children still in memory
+    };
+    
+    //Ordering the open list by lowest f, deepest first on ties
+    auto openOrder = [](const TreeNode* lhs, const TreeNode* rhs)
+    {
+        if(lhs->openKey != rhs->openKey)
+        {
+            return lhs->openKey < rhs->openKey;
+        }
+        if(lhs->state->moveCount != rhs->state->moveCount)
+        {
+            return lhs->state->moveCount > rhs->state->moveCount;
+        }
+        return lhs->id < rhs->id;
+    };
+    set<TreeNode*, decltype(openOrder)> openList(openOrder);
+    
+    int nodesInMemory = 0;
+    long nextId = 0;
+    
+    //Puts a node on the open list if it has children left to generate, using the f of those
+    //children as its place in line. Fully generated nodes come off the open list.
+    auto updateOpen = [&](TreeNode* node)
+    {
+        if(node->inOpen)
+        {
+            openList.erase(node);
+            node->inOpen = false;
+        }
+        
+        if(!node->expanded || node->children.empty())
+        {
+            node->openKey = node->f;
+        }
+        else if(node->forgottenF != unreachable)
+        {
+            node->openKey = node->forgottenF;
+        }
+        else
+        {
+            return;
+        }
+        
+        openList.insert(node);
+        node->inOpen = true;
+    };
+    
+    //Creating the root node
+    int startingEmptySpaceLocation = findEmptySpace(puzzleArray);
+    TreeNode* root = new TreeNode();
+    root->state = newState(puzzleArray, startingEmptySpaceLocation, 0, startingEmptySpaceLocation, NULL);
+    root->heuristic = cachedManhattanDistance(puzzleArray, context);
+    root->f = root->heuristic;
+    root->forgottenF = unreachable;
+    fill(root->forgottenChildF, root->forgottenChildF + 4, -1);
+    root->id = nextId++;
+    root->parent = NULL;
+    updateOpen(root);
+    nodesInMemory = 1;
+    result.totalNodeCount = 1;
+    
+    TreeNode* goalNode = NULL;
+    
+    while(!openList.empty())
+    {
+        TreeNode* best = *openList.begin();
+        
+        //Stopping early once a limit is reached
+        if(limiter.shouldStop(result, [&] { return (size_t) nodesInMemory * (sizeof(TreeNode) + sizeof(State) + 4 * sizeof(TreeNode*)); }, openList.size(), best->state->moveCount, best->openKey))
+        {
+            break;
+        }
+        
+        //Every branch left is too deep to fit in memory
+        if(best->openKey == unreachable)
+        {
+            break;
+        }
+        
+        //The first goal taken off the open list is the shortest one that fits in memory
+        if(best->heuristic == 0)
+        {
+            goalNode = best;
+            break;
+        }
+        
+        //Generating the children that are not in memory. A forgotten child comes back with the
+        //f it had when it was forgotten, so nothing learned about its branch is lost.
+        bool regenerating = best->expanded;
+        best->expanded = true;
+        
+        State* parent = best->state;
+        int space = parent->spaceLocation;
+        
+        //The grandparent's space location, moving back there would undo the last move
+        int lastSpace = parent->parent != NULL ? parent->parent->spaceLocation : -1;
+        
+        //Holds the locations the space can move to, indexed up, right, down, left
+        int moves[4] = {-1, -1, -1, -1};
+        
+        if(moveUp(space) && space - PUZZLE_WIDTH != lastSpace)
+        {
+            moves[0] = space - PUZZLE_WIDTH;
+        }
+        if(moveRight(space) && space + 1 != lastSpace)
+        {
+            moves[1] = space + 1;
+        }
+        if(moveDown(space) && space + PUZZLE_WIDTH != lastSpace)
+        {
+            moves[2] = space + PUZZLE_WIDTH;
+        }
+        if(moveLeft(space) && space - 1 != lastSpace)
+        {
+            moves[3] = space - 1;
+        }
+        
+        for(int m = 0; m < 4; m++)
+        {
+            //Skipping moves that are not possible, children still in memory and forgotten
+            //children that are already known to be out of reach
+            int forgottenF = best->forgottenChildF[m];
+            if(moves[m] == -1 || (regenerating && (forgottenF == -1 || forgottenF == unreachable)))
+            {
+                continue;
+            }
+            best->forgottenChildF[m] = -1;
+            
+            TreeNode* child = new TreeNode();
+            child->state = newState(parent->currentState, space, parent->moveCount + 1, moves[m], parent);
+            child->heuristic = cachedManhattanDistance(child->state->currentState, context);
+            child->forgottenF = unreachable;
+            fill(child->forgottenChildF, child->forgottenChildF + 4, -1);
+            child->id = nextId++;
+            child->parent = best;
+            
+            //A path that cannot be held in memory can never be returned
+            if(child->heuristic != 0 && child->state->moveCount >= nodeBudget - 1)
+            {
+                child->f = unreachable;
+            }
+            else
+            {
+                child->f = max(regenerating ? forgottenF : best->f, child->state->moveCount + child->heuristic);
+            }
+            
+            best->children.push_back(child);
+            updateOpen(child);
+            nodesInMemory++;
+            result.totalNodeCount++;
+        }
+        
+        //Only the forgotten children out of reach are still left out of memory
+        best->forgottenF = unreachable;
+        
+        //Backing the lowest child f up through the ancestors
+        for(TreeNode* node = best; node != NULL; node = node->parent)
+        {
+            int lowestF = node->forgottenF;
+            for(TreeNode* child : node->children)
+            {
+                lowestF = min(lowestF, child->f);
+            }
+            
+            bool changed = lowestF != node->f;
+            node->f = lowestF;
+            updateOpen(node);
+            
+            if(!changed && node != best)
+            {
+                break;
+            }
+        }
+        
+        //The best new child is never forgotten, otherwise a tight budget could drop and
+        //regenerate the same children forever
+        TreeNode* bestChild = NULL;
+        for(TreeNode* child : best->children)
+        {
+            if(bestChild == NULL || child->f < bestChild->f)
+            {
+                bestChild = child;
+            }
+        }
+        
+        //Forgetting the worst leaves until the tree fits in the budget
+        while(nodesInMemory > nodeBudget)
+        {
+            //Looking from the back of the open list for the highest f, shallowest leaf
+            TreeNode* worst = NULL;
+            for(auto it = openList.rbegin(); it != openList.rend(); ++it)
+            {
+                if((*it)->children.empty() && (*it)->parent != NULL && *it != bestChild)
+                {
+                    worst = *it;
+                    break;
+                }
+            }
+            
+            if(worst == NULL)
+            {
+                break;
+            }
+            
+            //Removing the leaf and keeping its f in the parent under the move that made it
+            TreeNode* owner = worst->parent;
+            int ownerSpace = owner->state->spaceLocation;
+            int leafSpace = worst->state->spaceLocation;
+            int move = leafSpace == ownerSpace - PUZZLE_WIDTH ? 0 : leafSpace == ownerSpace + 1 ? 1 : leafSpace == ownerSpace + PUZZLE_WIDTH ? 2 : 3;
+            
+            openList.erase(worst);
+            owner->children.erase(find(owner->children.begin(), owner->children.end(), worst));
+            owner->forgottenChildF[move] = worst->f;
+            owner->forgottenF = min(owner->forgottenF, worst->f);
+            updateOpen(owner);
+            
+            delete worst->state;
+            delete worst;
+            nodesInMemory--;
+            result.forgottenNodes++;
+        }
+    }
+    
+    //Copying the path out of the tree
+    vector<State> path;
+    if(goalNode != NULL)
+    {
+        for(State* state = goalNode->state; state != NULL; state = state->parent)
+        {
+            path.push_back(*state);
+        }
+        reverse(path.begin(), path.end());
+        
+        //Setting the g + h of each step from its place on the path
+        for(size_t step = 0; step < path.size(); step++)
+        {
+            path[step].manhattanDistance = (int) step + getManhattanDistance(path[step].currentState, context);
+        }
+    }
+    
+    //Estimating the memory held by the largest tree
+    result.memoryBytes = (size_t) min(nodeBudget, result.totalNodeCount) * (sizeof(TreeNode) + sizeof(State) + 4 * sizeof(TreeNode*));
+    
+    //Deleting the tree
+    vector<TreeNode*> toDelete(1, root);
+    while(!toDelete.empty())
+    {
+        TreeNode* node = toDelete.back();
+        toDelete.pop_back();
+        toDelete.insert(toDelete.end(), node->children.begin(), node->children.end());
+        delete node->state;
+        delete node;
+    }
+    
+    pathToStates(path, result);
+    
+    //Stopping timer
+    chrono::duration<double> elapsedTime = chrono::steady_clock::now() - start;
+    result.elapsedTime = elapsedTime.count();
+    
+    return result;
+}
+
+//---------------------------------------------------------------------------------------
+//pathToStates - Copies a path from start to goal into new states linked back to the start,
+//               giving them move counts that match their place on the path.
+//---------------------------------------------------------------------------------------
+void pathToStates(const vector<State>& path, SearchResult& result)
+{
+    State* parent = NULL;
+    
+    for(size_t step = 0; step < path.size(); step++)
+    {
+        State* state = new State(path[step]);
+        state->parent = parent;
+        state->moveCount = (int) step;
+        result.createdStates.push_back(state);
+        parent = state;
+    }
+    
+    result.goalState = parent;
+}
+
+//---------------------------------------------------------------------------------------
+//puzzleSolved - This bool checks to see if a puzzle is solved.
+//---------------------------------------------------------------------------------------
+bool puzzleSolved(PackedPuzzle puzzleArray, const SearchContext& context)
+{
+    PackedPuzzle goalArray = context.packedGoal;
+    
+    //if the two arrays are equal, return true
+    if (puzzleArray == goalArray)
+    {
+        return true;
+    }
+    
+    return false;
+}
+
+//---------------------------------------------------------------------------------------
+//findEmptySpace - Finds the empty space of the puzzle and returns its location
+//---------------------------------------------------------------------------------------
+int findEmptySpace(int puzzleArray[])
+{
+    //Variable to hold the spot of the empty location
+    int emptyLocation = 0;
+    
+    //For loop to check each spot of the array for the empty location '0'
+    //When it finds the location that == 0, sets it to our variable and then returns the location
+    for(int x = 0; x < PUZZLE_LENGTH; x++)
+    {
+        if(puzzleArray[x] == 0)
+        {
+            emptyLocation = x;
+        }
+    }
+    
+    return emptyLocation;
+}
+
+//------------------------------------------------------------------------------------------------
+//moveUp - If space is not in the top row; It can move up (returns true) else returns false.
+//------------------------------------------------------------------------------------------------
+bool moveUp(int spaceLocation)
+{
+    return spaceLocation >= PUZZLE_WIDTH;
+}
+
+//------------------------------------------------------------------------------------------------
+//moveRight - If space is not in the right column; It can move right (returns true) else returns false.
+//------------------------------------------------------------------------------------------------
+bool moveRight(int spaceLocation)
+{
+    return spaceLocation % PUZZLE_WIDTH != PUZZLE_WIDTH - 1;
+}
+
+//------------------------------------------------------------------------------------------------
+//moveDown - If space is not in the bottom row; It can move down (returns true) else returns false.
+//------------------------------------------------------------------------------------------------
+bool moveDown(int spaceLocation)
+{
+    return spaceLocation < PUZZLE_LENGTH - PUZZLE_WIDTH;
+}
+
+//------------------------------------------------------------------------------------------------
+//moveLeft - If space is not in the left column; It can move left (returns true) else returns false.
+//------------------------------------------------------------------------------------------------
+bool moveLeft(int spaceLocation)
+{
+    return spaceLocation % PUZZLE_WIDTH != 0;
+}
+
+//------------------------------------------------------------------------------------------------
+//legalMoves - Fills moves with the locations the space can move to, in the order up, right,
+//             down, left, and returns how many there are. A move back to lastSpace is left out,
+//             as it would undo the last move; pass -1 to keep every move.
+//------------------------------------------------------------------------------------------------
+int legalMoves(int spaceLocation, int lastSpace, int moves[])
+{
+    int moveTotal = 0;
+    
+    if(moveUp(spaceLocation) && spaceLocation - PUZZLE_WIDTH != lastSpace)
+    {
+        moves[moveTotal++] = spaceLocation - PUZZLE_WIDTH;
+    }
+    if(moveRight(spaceLocation) && spaceLocation + 1 != lastSpace)
+    {
+        moves[moveTotal++] = spaceLocation + 1;
+    }
+    if(moveDown(spaceLocation) && spaceLocation + PUZZLE_WIDTH != lastSpace)
+    {
+        moves[moveTotal++] = spaceLocation + PUZZLE_WIDTH;
+    }
+    if(moveLeft(spaceLocation) && spaceLocation - 1 != lastSpace)
+    {
+        moves[moveTotal++] = spaceLocation - 1;
+    }
+    
+    return moveTotal;
+}
+
+//------------------------------------------------------------------------------------------------
+//listSearch - Checks the context's list to see if the puzzle has been seen before
+//------------------------------------------------------------------------------------------------
+bool listSearch(PackedPuzzle puzzleArray, const SearchContext& context)
+{
+    return context.seenPuzzles.count(puzzleArray) != 0;
+}
+
+//----------------------------------------------------------------------
+//canonicalPuzzle - Packs a puzzle the way the context's seen list stores it. When mirrored
+//                  puzzles are the same distance from the goal, a puzzle and its mirror are
+//                  stored as the smaller of the two, so only one of them is ever searched.
+//----------------------------------------------------------------------
+PackedPuzzle canonicalPuzzle(int puzzleArray[], const SearchContext& context)
+{
+    PackedPuzzle packedPuzzle = arrayToIntConverter(puzzleArray);
+    
+    if(context.mirrorSeen)
+    {
+        int reflected[PUZZLE_LENGTH];
+        reflectPuzzle(puzzleArray, reflected);
+        packedPuzzle = min(packedPuzzle, arrayToIntConverter(reflected));
+    }
+    
+    return packedPuzzle;
+}
+
+//----------------------------------------------------------------------
+//countMisplacedTiles - This functon returns the number of misplaced tiles from the current state
+//----------------------------------------------------------------------
+int countMisplacedTiles(int puzzleArray[], const SearchContext& context)
+{
+    //Variable to holds the number of misplaced tiles
+    int numberMisplacedTiles = 0;
+    
+    //Checks each allocation of the array to determine how many tiles are out of place.
+    for(int i = 0; i < PUZZLE_LENGTH; i++)
+    {
+        //If the current state tile being check is not equal to the goal tile
+        //incrememnt the count
+        if(puzzleArray[i] != context.goal[i])
+        {
+            numberMisplacedTiles++;
+        }
+    }
+    
+    //Return the number of misplaced tiles.
+    return numberMisplacedTiles;
+}
+
+//----------------------------------------------------------------------
+//getInvCount - Function to count inversions in given array 'arr[]'
+//----------------------------------------------------------------------
+int getInvCount(int puzzleArray[])
+{
+    //Holds the number of inversions
+    int inv_count = 0;
+    
+    
+    for (int i = 0; i < PUZZLE_LENGTH - 1; i++)
+    {
+        for (int j = i + 1; j < PUZZLE_LENGTH; j++)
+        {
+            // Value 0 is used for empty space
+            if (puzzleArray[j] && puzzleArray[i] &&  puzzleArray[i] > puzzleArray[j])
+            {
+                //Incrementing the inversion count
+                inv_count++;
+            }
+        }
+    }
+    
+    //Returns the number of inversions
+    return inv_count;
+}
+
+//----------------------------------------------------------------------
+//permutationParity - Returns 1 if the tiles, leaving out the space, have an odd number of
+//                    inversions and 0 if even, the same as getInvCount % 2 but in one pass.
+//                    Each cycle of the puzzle as a permutation of its squares takes one swap
+//                    less than its length to undo, and the space adds one inversion for
+//                    every tile ahead of it. Returns -1 if a tile is missing or repeated.
+//----------------------------------------------------------------------
+int permutationParity(int puzzleArray[])
+{
+    //Bit x is set once square x has been walked through
+    unsigned int visited = 0;
+    int cycles = 0;
+    int spaceLocation = -1;
+    
+    //Checking every tile is on the board once
+    for(int i = 0; i < PUZZLE_LENGTH; i++)
+    {
+        if(puzzleArray[i] < 0 || puzzleArray[i] >= PUZZLE_LENGTH || (visited & (1u << puzzleArray[i])))
+        {
+            return -1;
+        }
+        
+        visited |= 1u << puzzleArray[i];
+        
+        if(puzzleArray[i] == 0)
+        {
+            spaceLocation = i;
+        }
+    }
+    
+    //Following each cycle from its first square
+    visited = 0;
+    for(int i = 0; i < PUZZLE_LENGTH; i++)
+    {
+        if(visited & (1u << i))
+        {
+            continue;
+        }
+        
+        cycles++;
+        for(int square = i; !(visited & (1u << square)); square = puzzleArray[square])
+        {
+            visited |= 1u << square;
+        }
+    }
+    
+    return (PUZZLE_LENGTH - cycles + spaceLocation) & 1;
+}
+
+//----------------------------------------------------------------------
+//isSolvable - This function returns true if given puzzle is solvable. On a board with an odd
+//             width a move never changes whether the inversion count is even. On an even
+//             width each move up or down flips it, so the rows the space is above the bottom
+//             row are added in. A board missing a tile is never solvable.
+//----------------------------------------------------------------------
+bool isSolvable(int puzzleArray[])
+{
+    //Getting whether the inversion count is odd without counting every pair
+    int parity = permutationParity(puzzleArray);
+    
+    if(parity == -1)
+    {
+        return false;
+    }
+    
+    if(PUZZLE_WIDTH % 2 == 0)
+    {
+        parity ^= (PUZZLE_HEIGHT - 1 - findEmptySpace(puzzleArray) / PUZZLE_WIDTH) & 1;
+    }
+    
+    // return true if inversion count is even.
+    return parity == 0;
+}
+
+//----------------------------------------------------------------------
+//canReachGoal - Returns true if the goal can be reached from the puzzle. No move changes
+//               what isSolvable works out, so the two must match.
+//----------------------------------------------------------------------
+bool canReachGoal(int puzzleArray[], int goalArray[])
+{
+    return isSolvable(puzzleArray) == isSolvable(goalArray);
+}
+
+//----------------------------------------------------------------------
+//getManhattenDistance - This function returns the absolute value of how many moves the puzzle is out of place
+//----------------------------------------------------------------------
+int getManhattanDistance(int puzzleArray[], const SearchContext& context)
+{
+    // Function variables
+    int manhattanDistance = 0;
+    
+    //Holds the row and column of the searched value in the for loop.
+    int puzzleRow = 0;
+    int puzzleColumn = 0;
+    
+    //Holds the row and column of the searched value in the goal
+    int solvedRow = 0;
+    int solvedColumn = 0;
+    
+    // For loop used to calculate the Manhattan distance
+    for (int x = 0; x < PUZZLE_LENGTH; x++)
+    {
+        //Skipping the empty space, counting it would overestimate the moves left
+        if (context.goal[x] == 0)
+        {
+            continue;
+        }
+        
+        //Setting the location of the searched array row and column
+        getRowAndColumn(puzzleArray, context.goal[x], puzzleRow, puzzleColumn);
+        
+        //Setting the location of the goal row and column
+        solvedRow = x / PUZZLE_WIDTH;
+        solvedColumn = x % PUZZLE_WIDTH;
+        
+        //Calculating the distance
+        manhattanDistance = manhattanDistance + abs((puzzleRow - solvedRow)) + abs((puzzleColumn - solvedColumn));
+        
+    }
+    
+    //Returns the manhattenDistance that was calculated
+    return manhattanDistance;
+}
+
+//----------------------------------------------------------------------
+//getRowandColumn - This function takes a tile and returns the row and column it is at.
+//----------------------------------------------------------------------
+void getRowAndColumn(int puzzleArray[], int tile, int& puzzleRow, int& puzzleColumn)
+{
+    // For loop used to get the index of the array and return the location of the column and row.
+    for (int x = 0; x < PUZZLE_LENGTH; x++)
+    {
+        //If statement to set the value for each row and column once the for loop locatates the correct value
+        if (puzzleArray[x] == tile)
+        {
+            puzzleRow = x / PUZZLE_WIDTH;
+            puzzleColumn = x % PUZZLE_WIDTH;
+        }
+    }
+}
+
+//----------------------------------------------------------------------
+//arrayToIntConverter - Will take a int array and convert it into a single number.
+//                      that will be used with the c++ list. Boards of more than 9 squares
+//                      are numbered by their place among every ordering of the tiles, plus
+//                      one so no puzzle packs to 0.
+//----------------------------------------------------------------------
+PackedPuzzle arrayToIntConverter(int puzzleArray[])
+{
+#if PUZZLE_LENGTH <= 9
+    int arrayInt = 0;
+
+    for (int i = 0; i < PUZZLE_LENGTH; i++)
+    {
+        arrayInt *= 10;
+        arrayInt += puzzleArray[i];
+    }
+    
+    return arrayInt;
+#else
+    //Bit x is set while tile x has not been placed yet
+    unsigned int tilesLeft = (1u << PUZZLE_LENGTH) - 1;
+    uint64_t arrayInt = 0;
+    
+    for (int i = 0; i < PUZZLE_LENGTH; i++)
+    {
+        //Counting the smaller tiles still left, in a base that shrinks by one each square
+        arrayInt *= PUZZLE_LENGTH - i;
+        arrayInt += __builtin_popcount(tilesLeft & ((1u << puzzleArray[i]) - 1));
+        tilesLeft &= ~(1u << puzzleArray[i]);
+    }
+    
+    return arrayInt + 1;
+#endif
+}
+
+//----------------------------------------------------------------------
+//splitMix64 - Seedable 64 bit random number generator. Advances the seed and returns
+//             the next number so the same seed always gives the same sequence.
+//----------------------------------------------------------------------
+uint64_t splitMix64(uint64_t& seed)
+{
+    uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+//----------------------------------------------------------------------
+//randomWalkPuzzle - Fills the array with the solved puzzle scrambled by a number of random
+//                   moves. A move never undoes the one before it.
+//----------------------------------------------------------------------
+void randomWalkPuzzle(int puzzleArray[], int walkLength, uint64_t& seed)
+{
+    //Starting from the solved puzzle
+    for(int i = 0; i < PUZZLE_LENGTH; i++)
+    {
+        puzzleArray[i] = solvedPuzzle[i];
+    }
+    
+    int spaceLocation = findEmptySpace(puzzleArray);
+    int lastSpaceLocation = -1;
+    
+    for(int step = 0; step < walkLength; step++)
+    {
+        //Holds the locations the space can move to
+        int moves[4];
+        int moveTotal = legalMoves(spaceLocation, lastSpaceLocation, moves);
+        
+        //Moving the space to one of them
+        int newSpace = moves[splitMix64(seed) % moveTotal];
+        swap(puzzleArray[spaceLocation], puzzleArray[newSpace]);
+        lastSpaceLocation = spaceLocation;
+        spaceLocation = newSpace;
+    }
+}
+
+//----------------------------------------------------------------------
+//solvablePuzzleCount - Returns the number of solvable puzzles. The blank can be in any slot
+//                      and the tiles can be in any order with an even number of inversions.
+//----------------------------------------------------------------------
+uint64_t solvablePuzzleCount()
+{
+    uint64_t count = PUZZLE_LENGTH;
+    
+    for(int i = 2; i < PUZZLE_LENGTH; i++)
+    {
+        count *= i;
+    }
+    
+    return count / 2;
+}
+
+//----------------------------------------------------------------------
+//unrankSolvablePuzzle - Turns a number from 0 to solvablePuzzleCount() - 1 into its own
+//                       solvable puzzle. The rank picks the blank slot and then the tiles
+//                       one at a time from the ones left. The second to last pick is set by
+//                       the parity so far, which gives the inversion count isSolvable needs.
+//----------------------------------------------------------------------
+void unrankSolvablePuzzle(uint64_t rank, int puzzleArray[])
+{
+    //Picking the slot for the blank
+    int spaceLocation = (int) (rank % PUZZLE_LENGTH);
+    rank /= PUZZLE_LENGTH;
+    
+    //Bit x is set while tile x has not been placed yet
+    unsigned int tilesLeft = ((1u << PUZZLE_LENGTH) - 1) & ~1u;
+    
+    //Holds the parity of the inversions of the tiles placed so far, started at the parity the
+    //space's row adds on an even width so the total comes out even
+    int parity = PUZZLE_WIDTH % 2 == 0 ? (PUZZLE_HEIGHT - 1 - spaceLocation / PUZZLE_WIDTH) & 1 : 0;
+    
+    int tileCount = PUZZLE_LENGTH - 1;
+    int slot = 0;
+    
+    for(int placed = 0; placed < tileCount; placed++)
+    {
+        //Skipping over the blank slot
+        if(slot == spaceLocation)
+        {
+            puzzleArray[slot++] = 0;
+        }
+        
+        //Choosing which of the tiles left goes here. Picking the i-th smallest tile
+        //adds i inversions, so the last two picks are forced to keep the parity even.
+        int tilesRemaining = tileCount - placed;
+        int pick;
+        
+        if(tilesRemaining > 2)
+        {
+            pick = (int) (rank % tilesRemaining);
+            rank /= tilesRemaining;
+        }
+        else if(tilesRemaining == 2)
+        {
+            pick = parity;
+        }
+        else
+        {
+            pick = 0;
+        }
+        
+        parity ^= pick & 1;
+        
+        //Finding the pick-th smallest tile left
+        unsigned int bits = tilesLeft;
+        for(int skip = 0; skip < pick; skip++)
+        {
+            bits &= bits - 1;
+        }
+        
+        int tile = __builtin_ctz(bits);
+        tilesLeft &= ~(1u << tile);
+        puzzleArray[slot++] = tile;
+    }
+    
+    //The blank is in the last slot
+    if(slot == spaceLocation)
+    {
+        puzzleArray[slot] = 0;
+    }
+}
+
+//----------------------------------------------------------------------
+//randomSolvablePuzzle - Fills the array with a random solvable puzzle. Each solvable puzzle is
+//                       equally likely and the same seed always gives the same puzzles.
+//----------------------------------------------------------------------
+void randomSolvablePuzzle(int puzzleArray[], uint64_t& seed)
+{
+    unrankSolvablePuzzle(splitMix64(seed) % solvablePuzzleCount(), puzzleArray);
+}
+
+//----------------------------------------------------------------------
+//rankSolvablePuzzle - Turns a solvable puzzle back into the number unrankSolvablePuzzle
+//                     made it from.
+//----------------------------------------------------------------------
+uint64_t rankSolvablePuzzle(const int puzzleArray[])
+{
+    //Holds which of the tiles left was picked for each slot
+    int picks[PUZZLE_LENGTH];
+    int pickCount = 0;
+    int spaceLocation = 0;
+    
+    //Bit x is set while tile x has not been placed yet
+    unsigned int tilesLeft = ((1u << PUZZLE_LENGTH) - 1) & ~1u;
+    
+    for(int slot = 0; slot < PUZZLE_LENGTH; slot++)
+    {
+        int tile = puzzleArray[slot];
+        
+        if(tile == 0)
+        {
+            spaceLocation = slot;
+            continue;
+        }
+        
+        //The pick is the number of smaller tiles still left
+        picks[pickCount++] = __builtin_popcount(tilesLeft & ((1u << tile) - 1));
+        tilesLeft &= ~(1u << tile);
+    }
+    
+    //Folding the free picks back together, the last two picks were forced by the parity
+    uint64_t rank = 0;
+    for(int placed = pickCount - 3; placed >= 0; placed--)
+    {
+        rank = rank * (pickCount - placed) + picks[placed];
+    }
+    
+    return rank * PUZZLE_LENGTH + spaceLocation;
+}
+
+//----------------------------------------------------------------------
+//canonicalRank - Returns the rank the depth table keeps a puzzle under. On a square board a
+//                puzzle and its mirror on the diagonal need the same number of moves, so both
+//                are kept under the smaller of their two ranks.
+//----------------------------------------------------------------------
+uint64_t canonicalRank(const int puzzleArray[])
+{
+    uint64_t rank = rankSolvablePuzzle(puzzleArray);
+    
+    if(PUZZLE_WIDTH == PUZZLE_HEIGHT)
+    {
+        int reflected[PUZZLE_LENGTH];
+        reflectPuzzle(puzzleArray, reflected);
+        rank = min(rank, rankSolvablePuzzle(reflected));
+    }
+    
+    return rank;
+}
+
+//----------------------------------------------------------------------
+//buildDepthTable - Runs a breadth first search backwards from the solved puzzle over every
+//                  solvable puzzle, storing the optimal number of moves for each one and
+//                  grouping the puzzles by that number. Only builds the table once. Boards
+//                  with more puzzles than a 32 bit rank can hold are left without a table.
+//                  Only one puzzle of each mirrored pair is searched and put in a bucket, which
+//                  on a square board halves the time taken and the buckets' memory. The table
+//                  itself still has a byte for every puzzle.
+//----------------------------------------------------------------------
+void buildDepthTable()
+{
+    if(!depthTable.empty() || solvablePuzzleCount() > UINT32_MAX)
+    {
+        return;
+    }
+    
+    const unsigned char unvisited = 0xFF;
+    depthTable.assign(solvablePuzzleCount(), unvisited);
+    depthBuckets.clear();
+    
+    //Starting from the solved puzzle
+    vector<uint32_t> currentLayer(1, (uint32_t) rankSolvablePuzzle(solvedPuzzle));
+    depthTable[currentLayer[0]] = 0;
+    
+    int puzzleArray[PUZZLE_LENGTH];
+    
+    //Expanding one layer at a time until every puzzle has been reached
+    while(!currentLayer.empty())
+    {
+        int depth = (int) depthBuckets.size();
+        vector<uint32_t> nextLayer;
+        
+        for(uint32_t rank : currentLayer)
+        {
+            unrankSolvablePuzzle(rank, puzzleArray);
+            int space = findEmptySpace(puzzleArray);
+            
+            //Holds the locations the space can move to
+            int moves[4];
+            int moveTotal = legalMoves(space, -1, moves);
+            
+            for(int m = 0; m < moveTotal; m++)
+            {
+                swap(puzzleArray[space], puzzleArray[moves[m]]);
+                
+                uint32_t childRank = (uint32_t) canonicalRank(puzzleArray);
+                if(depthTable[childRank] == unvisited)
+                {
+                    depthTable[childRank] = (unsigned char) (depth + 1);
+                    nextLayer.push_back(childRank);
+                }
+                
+                swap(puzzleArray[space], puzzleArray[moves[m]]);
+            }
+        }
+        
+        depthBuckets.push_back(currentLayer);
+        currentLayer.swap(nextLayer);
+    }
+}
+
+//----------------------------------------------------------------------
+//optimalDepth - Returns the least number of moves that solves the puzzle, or -1 if the puzzle
+//               is not solvable or the board is too big for the depth table.
+//----------------------------------------------------------------------
+int optimalDepth(int puzzleArray[])
+{
+    if(!isSolvable(puzzleArray))
+    {
+        return -1;
+    }
+    
+    buildDepthTable();
+    
+    if(depthTable.empty())
+    {
+        return -1;
+    }
+    
+    return depthTable[canonicalRank(puzzleArray)];
+}
+
+//----------------------------------------------------------------------
+//depthTargetedPuzzle - Fills the array with a random puzzle whose optimal solution is exactly
+//                      depth moves. Each puzzle at that depth is equally likely. Returns false
+//                      if no puzzle has that depth. The buckets hold one puzzle of each mirrored
+//                      pair, so half the time the mirror is handed out instead. A puzzle that is
+//                      its own mirror is only taken on the first half, keeping it as likely as
+//                      the rest. Boards too big for the depth table use walkedDepthPuzzle.
+//----------------------------------------------------------------------
+bool depthTargetedPuzzle(int puzzleArray[], int depth, uint64_t& seed)
+{
+    buildDepthTable();
+    
+    if(depthTable.empty())
+    {
+        return walkedDepthPuzzle(puzzleArray, depth, seed);
+    }
+    
+    if(depth < 0 || depth >= (int) depthBuckets.size())
+    {
+        return false;
+    }
+    
+    const vector<uint32_t>& bucket = depthBuckets[depth];
+    
+    if(PUZZLE_WIDTH != PUZZLE_HEIGHT)
+    {
+        unrankSolvablePuzzle(bucket[splitMix64(seed) % bucket.size()], puzzleArray);
+        return true;
+    }
+    
+    while(true)
+    {
+        uint64_t pick = splitMix64(seed) % (2 * bucket.size());
+        unrankSolvablePuzzle(bucket[pick / 2], puzzleArray);
+        
+        if(pick % 2 == 0)
+        {
+            return true;
+        }
+        
+        int reflected[PUZZLE_LENGTH];
+        reflectPuzzle(puzzleArray, reflected);
+        
+        if(memcmp(reflected, puzzleArray, sizeof reflected) != 0)
+        {
+            memcpy(puzzleArray, reflected, sizeof reflected);
+            return true;
+        }
+    }
+}
+
+//----------------------------------------------------------------------
+//walkedDepthPuzzle - Fills the array with a puzzle whose optimal solution is exactly depth moves,
+//                    for boards too big for the depth table. Each try is a random walk from the
+//                    solved puzzle, which can be solved in at most as many moves as the walk. A
+//                    walk whose Manhattan distance equals its length is known to be optimal.
+//                    Any other walk is solved with A* to find its optimal depth. Walks that fold
+//                    back on themselves come out shallower than their length, so the walks are
+//                    made two moves longer each time one does. They are made shorter again when
+//                    A* runs out of nodes. Every move changes the optimal depth by one, so each
+//                    walk keeps the parity of depth. The puzzles are not equally likely. Returns
+//                    false if no try of DEPTH_WALK_ATTEMPTS gave one.
+//----------------------------------------------------------------------
+bool walkedDepthPuzzle(int puzzleArray[], int depth, uint64_t& seed)
+{
+    if(depth < 0)
+    {
+        return false;
+    }
+    
+    SearchContext context;
+    Limits limits;
+    limits.maxNodes = DEPTH_WALK_NODE_LIMIT;
+    
+    int walkLength = depth;
+    
+    for(int attempt = 0; attempt < DEPTH_WALK_ATTEMPTS; attempt++)
+    {
+        randomWalkPuzzle(puzzleArray, walkLength, seed);
+        
+        //Finding the optimal depth, -1 if A* ran out of nodes first
+        int optimal = walkLength;
+        
+        if(getManhattanDistance(puzzleArray, context) < walkLength)
+        {
+            SearchResult result = runManhattenDistanceSearch(puzzleArray, limits, context);
+            optimal = result.goalState != NULL ? result.goalState->moveCount : -1;
+            releaseSearchResult(result);
+        }
+        
+        if(optimal == depth)
+        {
+            return true;
+        }
+        
+        if(optimal >= 0 && optimal < depth)
+        {
+            walkLength += 2;
+        }
+        else if(optimal < 0 && walkLength > depth)
+        {
+            walkLength -= 2;
+        }
+    }
+    
+    return false;
+}
+
+//----------------------------------------------------------------------
+//TwoBitDepthTable::depthMod3 - Returns the optimal number of moves mod 3 for the puzzle with
+//                              this rank, or 3 if it has not been reached
+//----------------------------------------------------------------------
+int TwoBitDepthTable::depthMod3(uint64_t rank) const
+{
+    return (int) (words[rank / 32].load(memory_order_relaxed) >> (2 * (rank % 32))) & 3;
+}
+
+//----------------------------------------------------------------------
+//buildTwoBitDepthTable - Runs a breadth first search backwards from the solved puzzle over every
+//                        solvable puzzle, keeping only two bits per puzzle so that boards with
+//                        hundreds of millions of puzzles fit in memory. There is no list of
+//                        puzzles to expand; each layer sweeps the whole table, unranking the
+//                        puzzles at the current depth, moving the space and ranking the
+//                        children, and marks any child not reached yet with the next depth mod 3.
+//                        The sweep is split into ranges of ranks, one thread each.
+//
+//                        Every move takes the space to a square of the other colour on a
+//                        checkerboard, so a puzzle's depth is odd or even with the distance from
+//                        its space to the goal's. That is read straight off the rank and halves
+//                        the puzzles unranked per layer. Depth mod 3 on its own cannot tell a
+//                        puzzle at depth d from one at d - 6, so those are expanded again, but all
+//                        their children have been reached and nothing changes. Once fewer puzzles
+//                        are left unreached than would be expanded, the sweep turns around and
+//                        looks at each unreached puzzle for a neighbour at the current depth
+//                        instead. An unreached puzzle cannot be next to one at d - 6, so there
+//                        the value is exact.
+//
+//                        Marking only ever turns a 3 into the next depth, which is never the
+//                        depth being swept, so threads can mark the same word at once with an
+//                        atomic AND, and nothing they read is changed under them.
+//----------------------------------------------------------------------
+void buildTwoBitDepthTable(TwoBitDepthTable& table, int threadCount)
+{
+    uint64_t puzzleCount = solvablePuzzleCount();
+    uint64_t wordCount = (puzzleCount + 31) / 32;
+    threadCount = max(threadCount, 1);
+    
+    //Every puzzle starts not reached
+    table.words = vector<atomic<uint64_t>>(wordCount);
+    for(atomic<uint64_t>& word : table.words)
+    {
+        word.store(~0ULL, memory_order_relaxed);
+    }
+    table.layerSizes.assign(1, 1);
+    table.expansions = 0;
+    
+    //Starting from the solved puzzle
+    uint64_t goalRank = rankSolvablePuzzle(solvedPuzzle);
+    table.words[goalRank / 32].fetch_and(~(3ULL << (2 * (goalRank % 32))), memory_order_relaxed);
+    uint64_t unreachedCount = puzzleCount - 1;
+    
+    int goalSpace = 0;
+    while(solvedPuzzle[goalSpace] != 0)
+    {
+        goalSpace++;
+    }
+    int goalColour = (goalSpace / PUZZLE_WIDTH + goalSpace % PUZZLE_WIDTH) & 1;
+    
+    //Expanding one layer at a time until no new puzzle is reached
+    for(int depth = 0; ; depth++)
+    {
+        uint64_t depthCode = depth % 3;
+        uint64_t nextCode = (depth + 1) % 3;
+        atomic<uint64_t> reached{0};
+        atomic<uint64_t> expanded{0};
+        
+        //Holds the puzzles a forward sweep would expand, this layer and every sixth one before it
+        uint64_t forwardCount = 0;
+        for(int d = depth; d >= 0; d -= 6)
+        {
+            forwardCount += table.layerSizes[d];
+        }
+        bool backward = unreachedCount < forwardCount;
+        
+        //Holds the value and space colour of the puzzles to unrank in this layer
+        uint64_t sweepCode = backward ? 3 : depthCode;
+        int sweepColour = (depth + (backward ? 1 : 0)) & 1;
+        
+        auto sweep = [&](uint64_t firstWord, uint64_t lastWord)
+        {
+            int puzzleArray[PUZZLE_LENGTH];
+            uint64_t localReached = 0;
+            uint64_t localExpanded = 0;
+            
+            for(uint64_t w = firstWord; w < lastWord; w++)
+            {
+                uint64_t word = table.words[w].load(memory_order_relaxed);
+                
+                for(int i = 0; i < 32; i++)
+                {
+                    uint64_t rank = w * 32 + i;
+                    
+                    if(((word >> (2 * i)) & 3) != sweepCode || rank >= puzzleCount)
+                    {
+                        continue;
+                    }
+                    
+                    //Skipping puzzles whose space is on the wrong colour for this layer
+                    int space = (int) (rank % PUZZLE_LENGTH);
+                    if((((space / PUZZLE_WIDTH + space % PUZZLE_WIDTH) & 1) ^ goalColour) != sweepColour)
+                    {
+                        continue;
+                    }
+                    
+                    unrankSolvablePuzzle(rank, puzzleArray);
+                    localExpanded++;
+                    
+                    //Holds the locations the space can move to
+                    int moves[4];
+                    int moveTotal = legalMoves(space, -1, moves);
+                    
+                    for(int m = 0; m < moveTotal; m++)
+                    {
+                        swap(puzzleArray[space], puzzleArray[moves[m]]);
+                        uint64_t neighbourRank = rankSolvablePuzzle(puzzleArray);
+                        swap(puzzleArray[space], puzzleArray[moves[m]]);
+                        
+                        if(backward)
+                        {
+                            //Marking this puzzle once a neighbour is at the current depth
+                            if((uint64_t) table.depthMod3(neighbourRank) == depthCode)
+                            {
+                                table.words[w].fetch_and(~((3 ^ nextCode) << (2 * i)), memory_order_relaxed);
+                                localReached++;
+                                break;
+                            }
+                            
+                            continue;
+                        }
+                        
+                        atomic<uint64_t>& childWord = table.words[neighbourRank / 32];
+                        int shift = 2 * (int) (neighbourRank % 32);
+                        
+                        //Marking the child with the next depth if it has not been reached. The
+                        //plain load first saves the atomic on the children already reached.
+                        if(((childWord.load(memory_order_relaxed) >> shift) & 3) == 3)
+                        {
+                            uint64_t before = childWord.fetch_and(~((3 ^ nextCode) << shift), memory_order_relaxed);
+                            if(((before >> shift) & 3) == 3)
+                            {
+                                localReached++;
+                            }
+                        }
+                    }
+                }
+            }
+            
+            reached.fetch_add(localReached, memory_order_relaxed);
+            expanded.fetch_add(localExpanded, memory_order_relaxed);
+        };
+        
+        //Splitting the words into one range per thread
+        vector<thread> workers;
+        for(int t = 1; t < threadCount; t++)
+        {
+            workers.emplace_back(sweep, wordCount * t / threadCount, wordCount * (t + 1) / threadCount);
+        }
+        sweep(0, wordCount / threadCount);
+        
+        for(thread& worker : workers)
+        {
+            worker.join();
+        }
+        
+        table.expansions += expanded.load();
+        
+        if(reached.load() == 0)
+        {
+            break;
+        }
+        
+        table.layerSizes.push_back(reached.load());
+        unreachedCount -= reached.load();
+    }
+}
+
+//----------------------------------------------------------------------
+//twoBitOptimalDepth - Returns the least number of moves that solves the puzzle, counted by
+//                     stepping to a neighbour one move closer until the puzzle is solved, or -1
+//                     if the puzzle is not solvable or the table has not been built
+//----------------------------------------------------------------------
+int twoBitOptimalDepth(const TwoBitDepthTable& table, int puzzleArray[])
+{
+    if(!isSolvable(puzzleArray) || table.words.empty())
+    {
+        return -1;
+    }
+    
+    int puzzleCopy[PUZZLE_LENGTH];
+    memcpy(puzzleCopy, puzzleArray, sizeof puzzleCopy);
+    
+    int depth = 0;
+    int depthCode = table.depthMod3(rankSolvablePuzzle(puzzleCopy));
+    
+    while(memcmp(puzzleCopy, solvedPuzzle, sizeof puzzleCopy) != 0)
+    {
+        int space = findEmptySpace(puzzleCopy);
+        int closerCode = (depthCode + 2) % 3;
+        
+        //Holds the locations the space can move to
+        int moves[4];
+        int moveTotal = legalMoves(space, -1, moves);
+        
+        //Taking the first move that gets one closer, there is always one
+        for(int m = 0; m < moveTotal; m++)
+        {
+            swap(puzzleCopy[space], puzzleCopy[moves[m]]);
+            
+            if(table.depthMod3(rankSolvablePuzzle(puzzleCopy)) == closerCode)
+            {
+                break;
+            }
+            
+            swap(puzzleCopy[space], puzzleCopy[moves[m]]);
+        }
+        
+        depthCode = closerCode;
+        depth++;
+    }
+    
+    return depth;
+}
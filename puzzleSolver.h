@@ -0,0 +1,429 @@
+/*
+The slider puzzle solver. Every search, heuristic and puzzle helper the program
+uses lives here, and none of them read from or print to the console or a file,
+so the solver can be linked into any program. solve() is the entry point for
+callers that just want an answer; the lower level functions below it are used
+by the benchmarks and the puzzle generator.
+*/
+
+#ifndef PUZZLE_SOLVER_H
+#define PUZZLE_SOLVER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+//Width and height of the board. Other shapes are built with, for example,
+//-DPUZZLE_WIDTH=4 -DPUZZLE_HEIGHT=3 for a board four wide and three high. Each shape is its
+//own build, so every move test, row and column is worked out with constants the compiler
+//can fold.
+#ifndef PUZZLE_WIDTH
+#define PUZZLE_WIDTH 3
+#endif
+#ifndef PUZZLE_HEIGHT
+#define PUZZLE_HEIGHT 3
+#endif
+
+//Variable to hold the length of the puzzle
+#define PUZZLE_LENGTH (PUZZLE_WIDTH * PUZZLE_HEIGHT)
+
+static_assert(PUZZLE_WIDTH >= 2 && PUZZLE_HEIGHT >= 2, "the board must be at least 2x2");
+static_assert(PUZZLE_LENGTH <= 20, "a packed puzzle only holds boards of up to 20 squares");
+
+//Holds a puzzle packed into one number. Up to 9 squares this is the tiles read as a decimal
+//number. Bigger boards do not fit, so they are packed by their place in the list of every
+//ordering of the tiles, which fits 64 bits up to 20 squares.
+#if PUZZLE_LENGTH <= 9
+typedef int PackedPuzzle;
+#else
+typedef uint64_t PackedPuzzle;
+#endif
+
+//Mixes a packed puzzle into 64 bits for the hash tables that are keyed on it. Callers take the
+//top bits, which depend on every bit of the puzzle.
+static inline uint64_t hashPuzzle(PackedPuzzle packedPuzzle)
+{
+    return ((uint64_t) packedPuzzle ^ ((uint64_t) packedPuzzle >> 32)) * 0x9E3779B97F4A7C15ULL;
+}
+
+//Weight on the heuristic for the first anytime search, and how much it drops each stage
+#define ANYTIME_START_WEIGHT 3.0
+#define ANYTIME_WEIGHT_STEP 0.5
+
+//Seconds the anytime search gets when it is run without a time limit of its own
+#define ANYTIME_DEFAULT_BUDGET 1.0
+
+//Number of nodes the beam search keeps per layer, and the most layers it will search
+#define BEAM_DEFAULT_WIDTH 100
+#define BEAM_MAX_DEPTH 1000
+
+//Number of nodes the memory bounded search may hold when run without a budget of its own
+#define SMA_DEFAULT_NODE_BUDGET 20000
+
+//Number of solved puzzles the solution cache keeps before dropping the least recently used
+#define SOLUTION_CACHE_CAPACITY 256
+
+//Number of expansions between each look at the clock, the memory used and the cancellation token
+#define SEARCH_CHECK_INTERVAL 256
+
+//Number of boards each heuristic cache in a SearchContext remembers, a power of two
+#define HEURISTIC_CACHE_SIZE 16384
+
+//Number of random walks tried for a puzzle of a given depth on a board with no depth table, and
+//the most nodes the A* search that checks each walk's optimal depth may create
+#define DEPTH_WALK_ATTEMPTS 200
+#define DEPTH_WALK_NODE_LIMIT 1000000
+
+//This is the struct defined to be used in out list when the search is being performed
+struct State
+{
+    int currentState[PUZZLE_LENGTH];    //Holds the current array (puzzle)
+    int spaceLocation;                  //Holds the location of the empty slot
+    int misplacedTiles;                 //Holds the number of misplaced tiles
+    int manhattanDistance;              //Holds the number of manhattan distance
+    int moveCount;                      //Holds the number of times the space has moved
+    int frontierSlot;                   //Holds the state's place in an indexed frontier, -1 if none
+    
+    State* parent;                      //Holds the parent of the node for tracing path
+};
+
+// Comparison object to be used to order the heap for Misplaced tles
+struct comp
+{
+    bool operator()(const State* lhs, const State* rhs) const
+    {
+        return (lhs->misplacedTiles) > (rhs->misplacedTiles);
+    }
+};
+
+// Comparison object to be used to order the heap for Manhattan Distance
+struct mdcomp
+{
+    bool operator()(const State* lhs, const State* rhs) const
+    {
+        return (lhs->manhattanDistance) > (rhs->manhattanDistance);
+    }
+};
+
+//Names each search, in the same order as the solverTable
+enum Algorithm
+{
+    BREADTH_FIRST,
+    DEPTH_FIRST,
+    MISPLACED_TILES,
+    MANHATTAN_DISTANCE,
+    ANYTIME_WEIGHTED,
+    BEAM,
+    MEMORY_BOUNDED
+};
+
+//Names how good a solution the portfolio must hand back
+enum SolutionQuality
+{
+    ANY_SOLUTION,
+    OPTIMAL_SOLUTION
+};
+
+//This is the struct that holds a puzzle handed to solve(), 0 is the empty space
+struct Board
+{
+    int tiles[PUZZLE_LENGTH];
+};
+
+//Names why a search stopped before it could finish
+enum StopReason
+{
+    NOT_STOPPED,
+    NODE_LIMIT_REACHED,
+    MEMORY_LIMIT_REACHED,
+    DEADLINE_REACHED,
+    SEARCH_CANCELLED
+};
+
+//This is the struct a caller keeps to stop a search from another thread
+struct CancellationToken
+{
+    std::atomic<bool> cancelled{false};
+    
+    void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+    bool isCancelled() const { return cancelled.load(std::memory_order_relaxed); }
+};
+
+//This is the struct a search publishes its counters to every SEARCH_CHECK_INTERVAL expansions,
+//so another thread can watch a long search. The stores and loads are relaxed, as the numbers
+//are only shown and nothing waits on them.
+struct SearchProgress
+{
+    std::atomic<long> nodes{0};             //Holds the number of nodes created so far
+    std::atomic<size_t> openSize{0};        //Holds the number of states waiting to be expanded
+    std::atomic<int> depth{0};              //Holds the move count of the state being expanded
+    std::atomic<int> bound{-1};             //Holds that state's f value or score, -1 for none
+    std::atomic<size_t> memoryBytes{0};     //Holds the approximate memory held by the search
+};
+
+//This is the struct that holds the limits a search runs under. A search that reaches one of
+//the last four stops cleanly and hands back what it has counted so far.
+struct Limits
+{
+    double timeLimit = ANYTIME_DEFAULT_BUDGET;  //Holds the seconds the anytime search may run
+    int beamWidth = BEAM_DEFAULT_WIDTH;         //Holds the nodes the beam search keeps per layer
+    int nodeLimit = SMA_DEFAULT_NODE_BUDGET;    //Holds the nodes the memory bounded search may hold
+    
+    long maxNodes = 0;                          //Holds the most nodes a search may create, 0 for no limit
+    size_t maxMemory = 0;                       //Holds the most bytes a search may hold, 0 for no limit
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+    const CancellationToken* cancellation = NULL;   //Holds the token to stop on, NULL for none
+    
+    SearchProgress* progress = NULL;            //Holds where to publish the counters, NULL for nowhere
+};
+
+//This is the struct the anytime search reports after each stage
+struct AnytimeStage
+{
+    double weight;                      //Holds the weight used on the heuristic
+    double bound;                       //Holds how many times longer than optimal the solution can be
+    int solutionLength;                 //Holds the number of moves in the current solution
+    int expandedNodes;                  //Holds the number of nodes expanded so far
+    double elapsedTime;                 //Holds the seconds since the search started
+};
+
+//This is the struct solve() hands back. It owns everything in it, so there is nothing to release.
+struct SolveResult
+{
+    bool solved = false;                //Holds true if a solution was found
+    std::vector<State> path;            //Holds the states from start to goal, empty if unsolved
+    int totalNodeCount = 0;             //Holds the number of nodes created
+    double elapsedTime = 0.0;           //Holds the time the search took in seconds
+    size_t memoryBytes = 0;             //Holds the approximate memory held by the search
+    bool fromCache = false;             //Holds true if the result came from the solution cache
+    int forgottenNodes = 0;             //Holds the number of nodes dropped to stay in the memory budget
+    StopReason stopReason = NOT_STOPPED;    //Holds which limit stopped the search early, if any
+    Algorithm algorithm = BREADTH_FIRST;    //Holds the search that produced the result
+    
+    std::vector<AnytimeStage> anytimeStages;    //Holds each solution the anytime search found
+};
+
+//This is the struct used to hand the outcome of a search back to the caller
+struct SearchResult
+{
+    State* goalState = NULL;            //Holds the solved state, NULL if no solution was found
+    int totalNodeCount = 0;             //Holds the number of nodes created
+    double elapsedTime = 0.0;           //Holds the time the search took in seconds
+    size_t memoryBytes = 0;             //Holds the approximate memory held by the search
+    bool fromCache = false;             //Holds true if the result came from the solution cache
+    int forgottenNodes = 0;             //Holds the number of nodes dropped to stay in the memory budget
+    StopReason stopReason = NOT_STOPPED;    //Holds which limit stopped the search early, if any
+    
+    std::vector<State*> createdStates;  //Holds every state allocated so they can be released
+};
+
+//This is the struct that remembers heuristic values already worked out, keyed by the packed
+//board, so a board reached again along another path costs one lookup. It is direct mapped:
+//each board can only sit in the one slot its packed number picks, and a new board takes the
+//slot over. The slots are made on first use and kept from search to search, since a value
+//only changes with the goal.
+struct HeuristicCache
+{
+    struct Entry
+    {
+        PackedPuzzle puzzle;            //Holds the board in this slot, 0 when empty
+        int value;                      //Holds the board's heuristic value
+    };
+    
+    std::vector<Entry> entries;         //Holds the slots, HEURISTIC_CACHE_SIZE of them once used
+    uint64_t hits = 0;                  //Holds the number of lookups answered from a slot
+    uint64_t misses = 0;                //Holds the number of lookups that worked the value out
+    
+    void clear();
+    double hitRate() const;
+};
+
+//This is the struct that holds everything a search changes while it runs, so searches in
+//different contexts never share state and any number of threads can solve at once with one
+//context each. A context can be reused solve after solve on the same thread, keeping the
+//memory its seen list has grown to. Toward the standard goal on a square board a puzzle and
+//its mirror on the diagonal share one entry in the seen list, halving what it holds.
+struct SearchContext
+{
+    int goal[PUZZLE_LENGTH] = {};           //Holds the puzzle the searches solve toward
+    PackedPuzzle packedGoal;                //Holds the goal packed into one number
+    bool mirrorSeen;                        //Holds true if mirrored puzzles share a seen list entry
+    std::unordered_set<PackedPuzzle> seenPuzzles;   //Holds the puzzles already seen, packed
+    
+    //Hold the heuristic values worked out so far. Filling them in does not change what a
+    //search sees, so the heuristics can update them through a const context.
+    mutable HeuristicCache manhattanCache;
+    mutable HeuristicCache misplacedCache;
+    
+    SearchContext();
+    explicit SearchContext(const int[]);
+    void setGoal(const int[]);
+    void reset();
+};
+
+//This is the struct that names a search for the benchmark suite
+struct SolverEntry
+{
+    const char* name;                   //Holds the name used on the command line
+    SearchResult (*run)(int[], const Limits&, SearchContext&);  //Holds the search to run
+    Algorithm algorithm;                //Holds which search this is
+};
+
+//This is the struct that remembers finished searches so the same puzzle and search are
+//only solved once. It is safe to use from more than one thread.
+struct SolutionCache
+{
+    //Holds a finished search with copies of the states along its path
+    struct Entry
+    {
+        uint64_t key;                   //Holds the packed puzzle and the search
+        std::vector<State> path;        //Holds the states from start to goal, empty if unsolved
+        int totalNodeCount;             //Holds the number of nodes the search created
+        double elapsedTime;             //Holds the time the search took in seconds
+        size_t memoryBytes;             //Holds the approximate memory held by the search
+    };
+    
+    size_t capacity = SOLUTION_CACHE_CAPACITY;
+    std::atomic<size_t> hits{0};        //Counted as atomics so they can be read without the lock
+    std::atomic<size_t> misses{0};
+    
+    std::list<Entry> entries;                                               //Most recently used first
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> lookupTable;   //Finds an entry by key
+    std::mutex cacheMutex;
+    
+    bool lookup(int[], Algorithm, SearchResult&);
+    void store(int[], Algorithm, const SearchResult&);
+    void clear();
+};
+
+//This is the struct that counts how each search has done in portfolio races, so the searches
+//a portfolio runs can be tuned. Atomic counters let each race record without a lock.
+struct PortfolioStats
+{
+    std::atomic<long> races[MEMORY_BOUNDED + 1];                //Holds the races each search was in
+    std::atomic<long> wins[MEMORY_BOUNDED + 1];                 //Holds the races each search won
+    std::atomic<uint64_t> winMicroseconds[MEMORY_BOUNDED + 1];  //Holds the total time of those wins
+    
+    void clear();
+};
+
+//This is the struct that holds a set of packed puzzles that many threads can add to at once
+//without a lock. It is an open addressing table of packed puzzles, 0 marking an empty slot, as
+//no packed puzzle is 0. Slots are claimed with a compare and swap and never emptied while in use,
+//so a lookup only has to walk forward until it finds the puzzle or an empty slot. The table
+//is sized once from a node budget and never grows.
+struct ConcurrentSeenSet
+{
+    std::vector<std::atomic<PackedPuzzle>> slots;   //Holds the packed puzzles, a power of two of them
+    size_t mask;                            //Holds the number of slots less one
+    std::atomic<size_t> count{0};           //Holds the number of puzzles added
+    
+    explicit ConcurrentSeenSet(size_t);
+    bool insert(PackedPuzzle);
+    bool contains(PackedPuzzle) const;
+    void clear();
+};
+
+//This is the struct that holds the optimal number of moves for every solvable puzzle mod 3, in
+//two bits each, indexed by rankSolvablePuzzle. Each move changes the optimal number by exactly
+//one, so a puzzle's neighbour one move closer is the one whose value is one less mod 3, and
+//following those counts out the full number.
+struct TwoBitDepthTable
+{
+    std::vector<std::atomic<uint64_t>> words;   //Holds 32 puzzles per word, 3 for one not reached
+    std::vector<uint64_t> layerSizes;           //Holds the number of puzzles at each depth
+    uint64_t expansions = 0;                    //Holds the number of puzzles expanded to build it
+    
+    int depthMod3(uint64_t) const;
+};
+
+//Solving
+Board makeBoard(const int[]);
+SolveResult solve(const Board&, Algorithm, const Limits& = Limits());
+SolveResult solve(const Board&, Algorithm, const Limits&, SearchContext&);
+SolveResult solve(const Board&, const Board&, Algorithm, const Limits& = Limits());
+SolveResult solve(const Board&, const Board&, Algorithm, const Limits&, SearchContext&);
+SolveResult solvePortfolio(const Board&, const std::vector<Algorithm>&, SolutionQuality, const Limits& = Limits());
+bool findsShortestSolution(Algorithm);
+
+//Searches
+State* newState(int[], int, int, int, State*);
+int expandState(State*, State*[], bool, SearchResult&, SearchContext&);
+SearchResult runBreadthFirstSearch(int[], const Limits&, SearchContext&);
+SearchResult runDepthFirstSearch(int[], const Limits&, SearchContext&);
+SearchResult runMisplacedTilesSearch(int[], const Limits&, SearchContext&);
+SearchResult runManhattenDistanceSearch(int[], const Limits&, SearchContext&);
+SearchResult runAnytimeSearch(int[], const Limits&, SearchContext&, const std::function<void(const AnytimeStage&)>&);
+SearchResult runAnytimeSearch(int[], const Limits&, SearchContext&);
+SearchResult runBeamSearch(int[], const Limits&, SearchContext&);
+SearchResult runMemoryBoundedSearch(int[], const Limits&, SearchContext&);
+SearchResult cachedSearch(int[], Algorithm, const Limits&, SearchContext&);
+const char* stopReasonName(StopReason);
+void releaseSearchResult(SearchResult&);
+void pathToStates(const std::vector<State>&, SearchResult&);
+
+//Puzzle helpers
+bool puzzleSolved(PackedPuzzle, const SearchContext&);
+int findEmptySpace(int[]);
+bool moveUp(int);
+bool moveRight(int);
+bool moveDown(int);
+bool moveLeft(int);
+int legalMoves(int, int, int[]);
+bool listSearch(PackedPuzzle, const SearchContext&);
+PackedPuzzle canonicalPuzzle(int[], const SearchContext&);
+void reflectPuzzle(const int[], int[]);
+int countMisplacedTiles(int[], const SearchContext&);
+bool isSolvable(int[]);
+bool canReachGoal(int[], int[]);
+int getInvCount(int[]);
+int permutationParity(int[]);
+int getManhattanDistance(int[], const SearchContext&);
+int cachedManhattanDistance(int[], const SearchContext&);
+int cachedMisplacedTiles(int[], const SearchContext&);
+void getRowAndColumn(int[], int, int&, int&);
+PackedPuzzle arrayToIntConverter(int[]);
+
+//Puzzle generation
+uint64_t splitMix64(uint64_t&);
+void randomWalkPuzzle(int[], int, uint64_t&);
+uint64_t solvablePuzzleCount();
+void unrankSolvablePuzzle(uint64_t, int[]);
+void randomSolvablePuzzle(int[], uint64_t&);
+uint64_t rankSolvablePuzzle(const int[]);
+uint64_t canonicalRank(const int[]);
+void buildDepthTable();
+int optimalDepth(int[]);
+bool depthTargetedPuzzle(int[], int, uint64_t&);
+bool walkedDepthPuzzle(int[], int, uint64_t&);
+void buildTwoBitDepthTable(TwoBitDepthTable&, int);
+int twoBitOptimalDepth(const TwoBitDepthTable&, int[]);
+
+//Holds the ideal state of the puzzle, the goal a SearchContext starts with
+extern const int* const solvedPuzzle;
+
+//Holds every search the benchmark suite knows how to run
+extern SolverEntry solverTable[MEMORY_BOUNDED + 1];
+
+//Holds the searches that have already been solved
+extern SolutionCache solutionCache;
+
+//Holds the searches a portfolio races when the caller has no list of its own
+extern const std::vector<Algorithm> defaultPortfolio;
+
+//Holds how each search has done in portfolio races
+extern PortfolioStats portfolioStats;
+
+//Holds the ranks of the puzzles at each optimal depth, one of each mirrored pair on a square
+//board, filled in by buildDepthTable
+extern std::vector<std::vector<uint32_t>> depthBuckets;
+
+#endif